@@ -0,0 +1,25 @@
+#ifndef ALLOCGUARD_H
+#define ALLOCGUARD_H
+
+/**
+ * @class AllocationGuard
+ * @brief Marks a scope in which the current thread must not allocate
+ * @details In a build with SEARCH_ALLOC_GUARD defined (make ALLOC_GUARD=1), any
+ *          operator new on the guarded thread prints a message and aborts, so a
+ *          debugger shows the offending call. In normal builds the guard does nothing.
+ */
+class AllocationGuard
+{
+public:
+#ifdef SEARCH_ALLOC_GUARD
+    AllocationGuard();
+    ~AllocationGuard();
+#else
+    AllocationGuard() {}
+#endif
+
+    AllocationGuard(const AllocationGuard &) = delete;
+    AllocationGuard &operator=(const AllocationGuard &) = delete;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef ANALYZER_H
+#define ANALYZER_H
+
+#include "Board.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+/**
+ * @class Analyzer
+ * @brief Background analysis for the terminal game
+ * @details Runs an infinite search of a position on its own thread and prints a line
+ *          with depth, score and principal variation after every iteration, while the
+ *          game keeps reading moves. The transposition table outlives each search,
+ *          so analysis of the next position starts from what was already found.
+ */
+class Analyzer
+{
+public:
+    /**
+     * @brief Constructs an idle analyzer; the table is allocated on first use
+     * @param hashMb Size of the transposition table in MiB
+     */
+    explicit Analyzer(size_t hashMb = 16);
+
+    /**
+     * @brief Stops any running analysis
+     */
+    ~Analyzer();
+
+    Analyzer(const Analyzer &) = delete;
+    Analyzer &operator=(const Analyzer &) = delete;
+
+    /**
+     * @brief Analyzes a position, replacing the current analysis unless it is of the same position
+     * @param board Position to analyze; copied
+     */
+    void analyze(const Board &board);
+
+    /**
+     * @brief Stops the running analysis and waits for its thread
+     */
+    void stop();
+
+    /**
+     * @brief Checks if an analysis thread has been started and not stopped
+     * @return true while analyzing
+     */
+    bool isRunning() const { return worker.joinable(); }
+
+private:
+    size_t hashMb;
+    std::unique_ptr<TranspositionTable> table;
+    std::unique_ptr<Search> search;
+    std::atomic<bool> stopping;    ///< Watched by the search; not reset when a search starts
+    std::thread worker;
+    uint64_t key;                  ///< Zobrist key of the position being analyzed
+};
+
+#endif
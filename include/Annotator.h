@@ -0,0 +1,78 @@
+#ifndef ANNOTATOR_H
+#define ANNOTATOR_H
+
+#include "Board.h"
+#include "Move.h"
+#include "Search.h"
+#include <string>
+#include <vector>
+
+/**
+ * @enum MoveJudgement
+ * @brief Verdict on a played move
+ */
+enum class MoveJudgement
+{
+    NONE,       ///< A reasonable move, not the engine's choice
+    BEST,       ///< The engine's choice
+    MISTAKE,    ///< Loses at least Annotator::MISTAKE_LOSS centipawns
+    BLUNDER     ///< Loses at least Annotator::BLUNDER_LOSS centipawns
+};
+
+/**
+ * @struct MoveReview
+ * @brief Evaluation of one played move
+ */
+struct MoveReview
+{
+    Color side = Color::WHITE;  ///< Side that played the move
+    int scoreBefore = 0;        ///< Score of the best move, for the side that moved
+    int scoreAfter = 0;         ///< Score after the played move, for the side that moved
+    Move bestMove;              ///< Engine's choice, or a null move
+    std::string bestSan;        ///< bestMove in SAN
+    MoveJudgement judgement = MoveJudgement::NONE;
+};
+
+/**
+ * @class Annotator
+ * @brief Post-game review: searches every position of a game and judges every move
+ * @details Positions are searched in parallel, last position first, by searches that
+ *          share one transposition table. Each position's search then finds the
+ *          positions after it already in the table, which deepens it for free.
+ */
+class Annotator
+{
+public:
+    static const int MISTAKE_LOSS = 100;
+    static const int BLUNDER_LOSS = 300;
+
+    /**
+     * @brief Constructs an annotator and its transposition table
+     * @param threads Number of positions searched at once
+     * @param hashMb Size of the shared transposition table in MiB
+     */
+    explicit Annotator(unsigned threads, size_t hashMb = 64);
+
+    /**
+     * @brief Reviews every move of a game
+     * @param start Position before the first move
+     * @param moves Legal moves of the game in order
+     * @param limits Budget of each position's search
+     * @return One review per move
+     */
+    std::vector<MoveReview> annotate(const Board &start, const std::vector<Move> &moves, const SearchLimits &limits);
+
+    /**
+     * @brief Formats a review as PGN annotations to follow the move
+     * @param review Review of the move
+     * @return NAG and comment, such as "$4 {Blunder (-2.10). Best was Nf3 (+0.30)}",
+     *         "$1" for the engine's choice, or an empty string
+     */
+    static std::string format(const MoveReview &review);
+
+private:
+    unsigned threadCount;
+    TranspositionTable table;
+};
+
+#endif
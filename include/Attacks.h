@@ -0,0 +1,168 @@
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "Pieces.h"
+#include "Square.h"
+
+/**
+ * @enum Direction
+ * @brief The eight ray directions, as seen from White's side of the board
+ * @details Rows grow towards rank 1, so SOUTH, EAST, SOUTH_EAST and SOUTH_WEST step
+ *          to higher square indices and the others to lower ones.
+ */
+enum Direction
+{
+    NORTH,
+    SOUTH,
+    EAST,
+    WEST,
+    NORTH_EAST,
+    NORTH_WEST,
+    SOUTH_EAST,
+    SOUTH_WEST,
+    DIRECTION_COUNT
+};
+
+/**
+ * @struct AttackTables
+ * @brief Attack masks of every piece from every square, computed at compile time
+ */
+struct AttackTables
+{
+    Bitboard knight[64];                ///< Knight moves from each square
+    Bitboard king[64];                  ///< King moves from each square
+    Bitboard pawn[2][64];               ///< Diagonal pawn captures, indexed by [color][square]
+    Bitboard ray[DIRECTION_COUNT][64];  ///< Squares from a square to the edge in one direction
+
+    constexpr AttackTables()
+        : knight(), king(), pawn(), ray()
+    {
+        const int knightSteps[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+        const int kingSteps[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+        const int raySteps[DIRECTION_COUNT][2] = {{-1, 0}, {1, 0}, {0, 1}, {0, -1}, {-1, 1}, {-1, -1}, {1, 1}, {1, -1}};
+
+        for (int square = 0; square < 64; square++)
+        {
+            int row = rowOf((Square)square);
+            int col = colOf((Square)square);
+
+            for (int i = 0; i < 8; i++)
+            {
+                Square target = makeSquare(row + knightSteps[i][0], col + knightSteps[i][1]);
+                if (target != NO_SQUARE)
+                    knight[square] |= 1ULL << target;
+
+                target = makeSquare(row + kingSteps[i][0], col + kingSteps[i][1]);
+                if (target != NO_SQUARE)
+                    king[square] |= 1ULL << target;
+            }
+
+            // White pawns capture towards row 0, Black pawns towards row 7
+            for (int side = -1; side <= 1; side += 2)
+            {
+                Square target = makeSquare(row - 1, col + side);
+                if (target != NO_SQUARE)
+                    pawn[(int)Color::WHITE][square] |= 1ULL << target;
+
+                target = makeSquare(row + 1, col + side);
+                if (target != NO_SQUARE)
+                    pawn[(int)Color::BLACK][square] |= 1ULL << target;
+            }
+
+            for (int dir = 0; dir < DIRECTION_COUNT; dir++)
+            {
+                for (int step = 1; step < 8; step++)
+                {
+                    Square target = makeSquare(row + step * raySteps[dir][0], col + step * raySteps[dir][1]);
+                    if (target == NO_SQUARE)
+                        break;
+                    ray[dir][square] |= 1ULL << target;
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief The attack tables, shared by every translation unit
+ */
+inline constexpr AttackTables ATTACK_TABLES{};
+
+/**
+ * @brief Gets the squares a knight attacks
+ * @param square Knight square
+ * @return Bitboard of attacked squares
+ */
+constexpr Bitboard knightAttacks(Square square) { return ATTACK_TABLES.knight[square]; }
+
+/**
+ * @brief Gets the squares a king attacks
+ * @param square King square
+ * @return Bitboard of attacked squares
+ */
+constexpr Bitboard kingAttacks(Square square) { return ATTACK_TABLES.king[square]; }
+
+/**
+ * @brief Gets the squares a pawn attacks
+ * @param color Pawn color
+ * @param square Pawn square
+ * @return Bitboard of the one or two diagonal squares in front of the pawn
+ */
+constexpr Bitboard pawnAttacks(Color color, Square square) { return ATTACK_TABLES.pawn[(int)color][square]; }
+
+/**
+ * @brief Gets the squares a slider attacks in one direction
+ * @param dir Ray direction
+ * @param square Slider square
+ * @param occupied All occupied squares
+ * @return Ray up to and including the first occupied square
+ */
+inline Bitboard rayAttacks(Direction dir, Square square, Bitboard occupied)
+{
+    Bitboard ray = ATTACK_TABLES.ray[dir][square];
+    Bitboard blockers = ray & occupied;
+    if (!blockers)
+        return ray;
+
+    // The nearest blocker is the lowest bit on rays towards higher squares, else the highest
+    bool increasing = dir == SOUTH || dir == EAST || dir == SOUTH_EAST || dir == SOUTH_WEST;
+    int blocker = increasing ? __builtin_ctzll(blockers) : 63 - __builtin_clzll(blockers);
+    return ray ^ ATTACK_TABLES.ray[dir][blocker];
+}
+
+/**
+ * @brief Gets the squares a rook attacks
+ * @param square Rook square
+ * @param occupied All occupied squares
+ * @return Bitboard of attacked squares, including the first piece on each ray
+ */
+inline Bitboard rookAttacks(Square square, Bitboard occupied)
+{
+    return rayAttacks(NORTH, square, occupied) | rayAttacks(SOUTH, square, occupied) |
+           rayAttacks(EAST, square, occupied) | rayAttacks(WEST, square, occupied);
+}
+
+/**
+ * @brief Gets the squares a bishop attacks
+ * @param square Bishop square
+ * @param occupied All occupied squares
+ * @return Bitboard of attacked squares, including the first piece on each ray
+ */
+inline Bitboard bishopAttacks(Square square, Bitboard occupied)
+{
+    return rayAttacks(NORTH_EAST, square, occupied) | rayAttacks(NORTH_WEST, square, occupied) |
+           rayAttacks(SOUTH_EAST, square, occupied) | rayAttacks(SOUTH_WEST, square, occupied);
+}
+
+/**
+ * @brief Gets the squares a queen attacks
+ * @param square Queen square
+ * @param occupied All occupied squares
+ * @return Bitboard of attacked squares, including the first piece on each ray
+ */
+inline Bitboard queenAttacks(Square square, Bitboard occupied)
+{
+    return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+}
+
+#endif
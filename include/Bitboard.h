@@ -0,0 +1,81 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "Pieces.h"
+#include "Square.h"
+#include <cstdint>
+
+/**
+ * @brief Gets the bitboard with only one square set
+ * @param row Row index (0-7)
+ * @param col Column index (0-7)
+ * @return Bitboard of that square
+ */
+inline Bitboard squareBit(int row, int col)
+{
+    return 1ULL << (row * 8 + col);
+}
+
+/**
+ * @brief Counts the squares in a set
+ * @param bb Bitboard to count
+ * @return Number of set bits
+ */
+inline int popCount(Bitboard bb)
+{
+    return __builtin_popcountll(bb);
+}
+
+/**
+ * @brief Removes and returns the lowest square of a non-empty set
+ * @param bb Bitboard to take the square from
+ * @return Square index (row * 8 + col)
+ */
+inline int popLowest(Bitboard &bb)
+{
+    int square = __builtin_ctzll(bb);
+    bb &= bb - 1;
+    return square;
+}
+
+/**
+ * @brief Flips a bitboard top to bottom (rank 1 becomes rank 8)
+ * @param bb Bitboard to flip
+ * @return Flipped bitboard
+ */
+inline Bitboard flipVertical(Bitboard bb)
+{
+    // Each row is one byte, so flipping the rows is a byte swap
+    return __builtin_bswap64(bb);
+}
+
+/**
+ * @brief Mirrors a bitboard left to right (the a-file becomes the h-file)
+ * @param bb Bitboard to mirror
+ * @return Mirrored bitboard
+ */
+inline Bitboard mirrorHorizontal(Bitboard bb)
+{
+    // Reverse the bits of every byte: swap neighbours, then pairs, then nibbles
+    const Bitboard k1 = 0x5555555555555555ULL;
+    const Bitboard k2 = 0x3333333333333333ULL;
+    const Bitboard k4 = 0x0F0F0F0F0F0F0F0FULL;
+    bb = ((bb >> 1) & k1) | ((bb & k1) << 1);
+    bb = ((bb >> 2) & k2) | ((bb & k2) << 2);
+    bb = ((bb >> 4) & k4) | ((bb & k4) << 4);
+    return bb;
+}
+
+/**
+ * @struct BitboardPosition
+ * @brief A position as piece bitboards plus state, suitable for transforming and hashing
+ */
+struct BitboardPosition
+{
+    Bitboard pieces[2][6] = {};  ///< [color][PieceType] squares
+    Color sideToMove = Color::WHITE;
+    uint8_t castling = 0;        ///< Bit 0 = K, 1 = Q, 2 = k, 3 = q
+    int8_t enPassantCol = -1;    ///< File of a capturable en passant target, or -1
+};
+
+#endif
@@ -1,21 +1,88 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include "Bitboard.h"
 #include "Pieces.h"
-#include <memory>
-#include <vector>
+#include "Move.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct MoveUndo
+ * @brief State saved by Board::makeMove so the move can be taken back
+ */
+struct MoveUndo
+{
+    uint8_t captured = 0;                ///< Packed code of the captured piece, 0 if none
+    Square capturedAt = NO_SQUARE;       ///< Square the captured piece stood on
+    uint8_t castlingRights = 0;          ///< Castling rights before the move
+    Square enPassantSquare = NO_SQUARE;  ///< En passant target square before the move
+    uint16_t halfmoveClock = 0;   ///< Halfmove clock before the move
+};
+
+/**
+ * @struct PackedPosition
+ * @brief A position in 38 bytes: the mailbox and the game state, without bitboards
+ */
+struct PackedPosition
+{
+    uint8_t mailbox[32];       ///< Piece code of every square, two squares per byte
+    uint8_t state;             ///< Bits 0-3 castling rights, bit 4 set when Black is to move
+    Square enPassantSquare;    ///< En passant target square, or NO_SQUARE
+    uint16_t halfmoveClock;
+    uint16_t fullmoveNumber;
+};
 
 /**
  * @class Board
  * @brief Manages the chess board state and piece positions
+ * @details The board is a plain value: piece bitboards, a packed mailbox, the
+ *          game state and its Zobrist key, with no pointers. Copying a Board is a
+ *          memcpy, so searches and worker threads can take snapshots instead of
+ *          undoing moves. Every change to the board updates the key in step.
  */
 class Board
 {
 private:
-    // Composition: Board contains pieces (Dynamic memory)
-    std::unique_ptr<Piece> squares[8][8];
-    Position enPassantTarget;
-    bool enPassantAvailable;
+    Bitboard byColor[2];      ///< Squares occupied by each color
+    Bitboard byType[6];       ///< Squares occupied by each PieceType
+    uint8_t mailbox[32];      ///< Piece code of every square, two squares per byte
+    Color sideToMove;
+    uint8_t castlingRights;   ///< Bit 0 = K, 1 = Q, 2 = k, 3 = q
+    Square enPassantSquare;   ///< En passant target square, or NO_SQUARE
+    uint16_t halfmoveClock;
+    uint16_t fullmoveNumber;
+    uint64_t key;             ///< Zobrist key of the pieces, side to move and castling rights
+
+    /**
+     * @brief Gets the packed piece code of a square
+     * @param square Square index
+     * @return 0 if empty, else (color << 3) | (piece type + 1)
+     */
+    uint8_t codeAt(Square square) const
+    {
+        return (mailbox[square >> 1] >> ((square & 1) * 4)) & 0xF;
+    }
+
+    /**
+     * @brief Puts a piece on an empty square
+     * @param square Square index
+     * @param code Packed piece code, not 0
+     */
+    void put(Square square, uint8_t code);
+
+    /**
+     * @brief Empties a square
+     * @param square Square index
+     * @return Packed code of the piece that stood there, or 0
+     */
+    uint8_t take(Square square);
+
+    /**
+     * @brief Replaces the castling rights, keeping the key in step
+     * @param rights New rights, bit 0 = K, 1 = Q, 2 = k, 3 = q
+     */
+    void setCastlingRights(uint8_t rights);
 
 public:
     /**
@@ -24,14 +91,34 @@ public:
     Board();
 
     /**
-     * @brief Default destructor
+     * @brief Initializes the board with starting chess position
      */
-    ~Board() = default;
+    void initialize();
 
     /**
-     * @brief Initializes the board with starting chess position
+     * @brief Sets up the board from a FEN string
+     * @param fen Position in Forsyth-Edwards Notation (clock fields are optional)
+     * @return true if the FEN was parsed, false if it is malformed
      */
-    void initialize();
+    bool loadFEN(const std::string &fen);
+
+    /**
+     * @brief Packs the position for compact storage
+     * @return Position without the bitboards, which unpack() rebuilds
+     */
+    PackedPosition pack() const;
+
+    /**
+     * @brief Sets up the board from a packed position
+     * @param packed Position produced by pack()
+     */
+    void unpack(const PackedPosition &packed);
+
+    /**
+     * @brief Describes the current position in Forsyth-Edwards Notation
+     * @return FEN string including side to move, castling rights and clocks
+     */
+    std::string toFEN() const;
 
     /**
      * @brief Displays the board in ASCII format
@@ -41,17 +128,17 @@ public:
     /**
      * @brief Gets piece at specified position
      * @param pos Position to query
-     * @return Pointer to piece, or nullptr if square is empty
+     * @return Pointer to the shared piece, or nullptr if square is empty
      */
-    Piece *getPiece(const Position &pos) const;
+    const Piece *getPiece(const Position &pos) const;
 
     /**
      * @brief Gets piece at specified row and column
      * @param row Row index (0-7)
      * @param col Column index (0-7)
-     * @return Pointer to piece, or nullptr if square is empty
+     * @return Pointer to the shared piece, or nullptr if square is empty
      */
-    Piece *getPiece(int row, int col) const;
+    const Piece *getPiece(int row, int col) const;
 
     /**
      * @brief Checks if a position is empty
@@ -87,18 +174,18 @@ public:
     bool movePiece(int fromRow, int fromCol, int toRow, int toCol);
 
     /**
-     * @brief Places a piece at the specified position
+     * @brief Places a piece at the specified position, replacing any piece there
      * @param pos Position to place piece
-     * @param piece unique_ptr to the piece to place
+     * @param piece Shared piece from Piece::get, or nullptr to empty the square
      */
-    void setPiece(const Position &pos, std::unique_ptr<Piece> piece);
+    void setPiece(const Position &pos, const Piece *piece);
 
     /**
      * @brief Removes and returns a piece from the board
      * @param pos Position to remove piece from
-     * @return unique_ptr to the removed piece, or nullptr if empty
+     * @return The removed piece, or nullptr if empty
      */
-    std::unique_ptr<Piece> removePiece(const Position &pos);
+    const Piece *removePiece(const Position &pos);
 
     /**
      * @brief Checks if the path between two positions is clear
@@ -116,6 +203,14 @@ public:
      */
     bool isUnderAttack(const Position &pos, Color byColor) const;
 
+    /**
+     * @brief Finds the pieces of specified color attacking a position
+     * @param pos Position to check
+     * @param byColor Color of attacking pieces
+     * @return Bitboard of the attacking pieces' squares
+     */
+    Bitboard getAttackers(const Position &pos, Color byColor) const;
+
     /**
      * @brief Finds the position of the king of specified color
      * @param color Color of the king to find
@@ -137,7 +232,84 @@ public:
      * @param color Color of the player making the move
      * @return true if move would result in check, false otherwise
      */
-    bool wouldBeInCheck(const Position &from, const Position &to, Color color);
+    bool wouldBeInCheck(const Position &from, const Position &to, Color color) const;
+
+    /**
+     * @brief Plays a move, including castling, en passant and promotion
+     * @param move Move to play; must be pseudo-legal for the side to move
+     * @return State needed to take the move back with unmakeMove
+     */
+    MoveUndo makeMove(const Move &move);
+
+    /**
+     * @brief Takes back a move played with makeMove
+     * @param move The move that was played
+     * @param undo State returned by makeMove for that move
+     */
+    void unmakeMove(const Move &move, MoveUndo &undo);
+
+    /**
+     * @brief Checks if a side keeps the right to castle on one wing
+     * @param color Color of the side
+     * @param kingSide true for kingside (O-O), false for queenside (O-O-O)
+     * @return true if neither the king nor that rook has moved
+     */
+    bool hasCastlingRight(Color color, bool kingSide) const
+    {
+        int bit = (color == Color::WHITE ? 0 : 2) + (kingSide ? 0 : 1);
+        return castlingRights & (1 << bit);
+    }
+
+    /**
+     * @brief Gets the squares occupied by one side
+     * @param color Color of the side
+     * @return Bitboard of that side's pieces
+     */
+    Bitboard getPieces(Color color) const { return byColor[(int)color]; }
+
+    /**
+     * @brief Gets the squares occupied by one piece type of one side
+     * @param color Color of the side
+     * @param type Piece type
+     * @return Bitboard of those pieces
+     */
+    Bitboard getPieces(Color color, PieceType type) const { return byColor[(int)color] & byType[(int)type]; }
+
+    /**
+     * @brief Gets every occupied square
+     * @return Bitboard of all pieces
+     */
+    Bitboard getOccupied() const { return byColor[0] | byColor[1]; }
+
+    /**
+     * @brief Gets the color whose turn it is
+     * @return Color of the side to move
+     */
+    Color getSideToMove() const { return sideToMove; }
+
+    /**
+     * @brief Sets the color whose turn it is
+     * @param color Color of the side to move
+     */
+    void setSideToMove(Color color);
+
+    /**
+     * @brief Gets the Zobrist key of the position, kept up to date by every move
+     * @return 64-bit position key, equal to Zobrist::hash(*this)
+     */
+    uint64_t getKey() const;
+
+    /**
+     * @brief Gets the number of halfmoves since the last capture or pawn move
+     * @return Halfmove clock used by the fifty-move rule
+     */
+    int getHalfmoveClock() const { return halfmoveClock; }
+
+    /**
+     * @brief Gets the fullmove number, starting at 1 and incremented after Black moves
+     * @return Current fullmove number
+     */
+    int getFullmoveNumber() const { return fullmoveNumber; }
 
     /**
      * @brief Sets the en passant target square
@@ -145,26 +317,25 @@ public:
      */
     void setEnPassantTarget(const Position &pos)
     {
-        enPassantTarget = pos;
-        enPassantAvailable = true;
+        enPassantSquare = pos.getSquare();
     }
 
     /**
      * @brief Clears the en passant target
      */
-    void clearEnPassant() { enPassantAvailable = false; }
+    void clearEnPassant() { enPassantSquare = NO_SQUARE; }
 
     /**
      * @brief Checks if en passant is currently available
      * @return true if en passant target is set, false otherwise
      */
-    bool isEnPassantAvailable() const { return enPassantAvailable; }
+    bool isEnPassantAvailable() const { return enPassantSquare != NO_SQUARE; }
 
     /**
      * @brief Gets the current en passant target position
-     * @return Position of the en passant target square
+     * @return Position of the en passant target square, invalid if there is none
      */
-    Position getEnPassantTarget() const { return enPassantTarget; }
+    Position getEnPassantTarget() const { return Position::fromSquare(enPassantSquare); }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include "Board.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class BoardRenderer
+ * @brief Draws boards to a file descriptor without allocating
+ * @details Each frame is formatted into a fixed buffer and sent with a single
+ *          write(). In ANSI mode the board is drawn once at the top of the screen
+ *          and later frames only rewrite the squares that changed.
+ */
+class BoardRenderer
+{
+private:
+    static const size_t BUFFER_SIZE = 4096;
+
+    int fd;
+    bool ansi;
+    bool hasFrame;               ///< true once a full ANSI frame is on screen
+    const Piece *shown[64];      ///< Piece drawn on each square in the last ANSI frame
+    char buffer[BUFFER_SIZE];
+    size_t used;
+
+    /**
+     * @brief Appends bytes to the frame buffer
+     * @param data Bytes to append
+     * @param length Number of bytes; the caller keeps frames within BUFFER_SIZE
+     */
+    void append(const char *data, size_t length);
+
+    /**
+     * @brief Appends a NUL-terminated string to the frame buffer
+     * @param text Text to append
+     */
+    void append(const char *text);
+
+    /**
+     * @brief Appends a cursor movement to a 1-based screen row and column
+     * @param row Screen row
+     * @param col Screen column
+     */
+    void appendCursor(int row, int col);
+
+    /**
+     * @brief Appends the complete board drawing
+     * @param board Board to draw
+     */
+    void appendFrame(const Board &board);
+
+    /**
+     * @brief Sends the buffer with one write() and empties it
+     */
+    void flush();
+
+public:
+    /**
+     * @brief Constructs a renderer
+     * @param fd File descriptor to draw to (standard output by default)
+     * @param ansi true to redraw only changed squares using ANSI cursor movement
+     */
+    explicit BoardRenderer(int fd = 1, bool ansi = false);
+
+    /**
+     * @brief Draws the board
+     * @param board Board to draw
+     */
+    void render(const Board &board);
+
+    /**
+     * @brief Forgets the last ANSI frame so the next render redraws everything
+     */
+    void invalidate() { hasFrame = false; }
+
+    /**
+     * @brief Checks if the renderer redraws only changed squares
+     * @return true in ANSI mode
+     */
+    bool isAnsi() const { return ansi; }
+};
+
+#endif
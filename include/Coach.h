@@ -0,0 +1,115 @@
+#ifndef COACH_H
+#define COACH_H
+
+#include "Board.h"
+#include "Move.h"
+#include "Search.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct CoachNote
+ * @brief Coaching remark about one played move
+ */
+struct CoachNote
+{
+    size_t ply;         ///< Index of the move in the game's history
+    std::string text;   ///< Remark such as "Nf3 hangs the bishop on e5 to dxe5"
+};
+
+/**
+ * @class Coach
+ * @brief Checks played moves for hanging pieces and missed or allowed mates in the background
+ * @details Checks run on a small pool of worker threads at the lowest scheduling
+ *          priority, so the game never waits for them. Each check is two short
+ *          searches, before and after the move. Asking for a new check cancels the
+ *          older ones at once, queued or running; notes arrive through the listener.
+ */
+class Coach
+{
+public:
+    /**
+     * @brief Constructs an idle coach; its threads start with the first check
+     * @param threads Number of worker threads, at least 1
+     * @param limits Budget of each of a check's two searches
+     */
+    explicit Coach(unsigned threads = 1, const SearchLimits &limits = defaultLimits());
+
+    /**
+     * @brief Cancels every check and joins the workers
+     */
+    ~Coach();
+
+    Coach(const Coach &) = delete;
+    Coach &operator=(const Coach &) = delete;
+
+    /**
+     * @brief Sets the function called with each note
+     * @param listener Called on a worker thread, once per note; must be set before the first check
+     */
+    void setListener(const std::function<void(const CoachNote &)> &listener) { onNote = listener; }
+
+    /**
+     * @brief Queues a check of a move, cancelling all earlier checks
+     * @param ply Index of the move in the game's history, passed back in the note
+     * @param before Position before the move; copied
+     * @param move Legal move played in that position
+     */
+    void check(size_t ply, const Board &before, const Move &move);
+
+    /**
+     * @brief Cancels every queued and running check without waiting
+     */
+    void cancel();
+
+    /**
+     * @brief Gets the default budget of a check's searches
+     * @return Depth 5, enough for mates in three, and at most 150 ms
+     */
+    static SearchLimits defaultLimits();
+
+private:
+    struct Job
+    {
+        size_t ply;
+        Board before;
+        Move move;
+    };
+
+    struct Worker
+    {
+        std::thread thread;
+        Search search;
+        std::atomic<bool> cancelled{false};    ///< Watched by the search; set for the job it is running
+    };
+
+    unsigned threadCount;
+    SearchLimits limits;
+    std::function<void(const CoachNote &)> onNote;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::deque<Job> jobs;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool quitting;
+
+    /**
+     * @brief Runs jobs until the coach is destroyed; body of every worker thread
+     */
+    void work(Worker &worker);
+
+    /**
+     * @brief Looks for a missed mate, an allowed mate or a piece left hanging
+     * @return The note text, or an empty string if the move is fine or the check was cancelled
+     */
+    std::string review(Worker &worker, const Job &job);
+};
+
+#endif
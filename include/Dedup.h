@@ -0,0 +1,134 @@
+#ifndef DEDUP_H
+#define DEDUP_H
+
+#include "Pgn.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct Fingerprint
+ * @brief Identifies a move sequence by a hash and its length in plies
+ */
+struct Fingerprint
+{
+    uint64_t hash = 0;
+    uint32_t length = 0;
+
+    bool operator==(const Fingerprint &other) const
+    {
+        return hash == other.hash && length == other.length;
+    }
+};
+
+/**
+ * @struct FingerprintHasher
+ * @brief Hash functor so fingerprints can key unordered containers
+ */
+struct FingerprintHasher
+{
+    size_t operator()(const Fingerprint &fp) const
+    {
+        return (size_t)(fp.hash ^ (fp.length * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
+/**
+ * @class FingerprintMap
+ * @brief Thread-safe map from fingerprint to the first game that produced it
+ * @details The map is split into independently locked shards chosen by the
+ *          fingerprint hash, so many threads can insert at once.
+ */
+class FingerprintMap
+{
+private:
+    static const size_t SHARD_COUNT = 64;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<Fingerprint, uint32_t, FingerprintHasher> entries;
+    };
+
+    Shard shards[SHARD_COUNT];
+
+    Shard &shardFor(const Fingerprint &fp) { return shards[(fp.hash >> 58) % SHARD_COUNT]; }
+
+public:
+    /**
+     * @brief Records a game, keeping the lowest game index per fingerprint
+     * @param fp Fingerprint of the game
+     * @param game Index of the game in the corpus
+     */
+    void insert(const Fingerprint &fp, uint32_t game);
+
+    /**
+     * @brief Looks up the first game with a fingerprint
+     * @param fp Fingerprint to look up
+     * @param game Receives the game index if found
+     * @return true if a game has this fingerprint, false otherwise
+     */
+    bool find(const Fingerprint &fp, uint32_t &game);
+};
+
+/**
+ * @enum GameStatus
+ * @brief Verdict of the deduplication pass for one game
+ */
+enum class GameStatus
+{
+    UNIQUE,     ///< Keep the game
+    DUPLICATE,  ///< Same moves as an earlier game
+    PREFIX,     ///< Its moves are the opening of a longer game
+    INVALID     ///< Moves could not be replayed (position mode only)
+};
+
+/**
+ * @class Deduplicator
+ * @brief Finds duplicate games and games that are prefixes of others
+ */
+class Deduplicator
+{
+public:
+    /**
+     * @enum Mode
+     * @brief How games are fingerprinted
+     */
+    enum class Mode
+    {
+        MOVES,      ///< Rolling hash of the normalized SAN move sequence from the starting position
+        POSITION    ///< Zobrist key of the position after each ply, plus the ply count
+    };
+
+private:
+    Mode mode;
+    bool dropPrefixes;
+
+public:
+    /**
+     * @brief Constructs a deduplicator
+     * @param fingerprintMode How games are fingerprinted
+     * @param removePrefixes true to also drop games whose moves start a longer game
+     */
+    explicit Deduplicator(Mode fingerprintMode = Mode::MOVES, bool removePrefixes = true)
+        : mode(fingerprintMode), dropPrefixes(removePrefixes) {}
+
+    /**
+     * @brief Classifies every game of a corpus
+     * @param games Games in corpus order; the first copy of a game is the one kept
+     * @param threads Number of worker threads
+     * @return One status per game
+     */
+    std::vector<GameStatus> run(const std::vector<PgnGame> &games, unsigned threads) const;
+
+    /**
+     * @brief Computes the fingerprint hash after every ply of a game
+     * @param game Game to fingerprint
+     * @param hashes Receives one hash per ply; the last one identifies the whole game
+     * @return true on success, false if the FEN tag is malformed or, in POSITION mode, a move is illegal
+     */
+    bool fingerprint(const PgnGame &game, std::vector<uint64_t> &hashes) const;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "Board.h"
+#include "Mcts.h"
+#include "Search.h"
+#include "SmpSearch.h"
+#include <memory>
+
+/**
+ * @enum EngineType
+ * @brief Which search an engine player uses
+ */
+enum class EngineType
+{
+    ALPHA_BETA,  ///< Lazy SMP alpha-beta search
+    MCTS         ///< Monte Carlo tree search
+};
+
+/**
+ * @class Engine
+ * @brief Computer player for the terminal game
+ * @details The engine keeps what it learned from one move to the next: the alpha-beta
+ *          search keeps its transposition table, aged by one generation per move, and
+ *          the tree search re-roots its tree at the position after the opponent's reply.
+ */
+class Engine
+{
+public:
+    /**
+     * @brief Constructs an engine
+     * @param type Search to use
+     * @param moveTimeMs Thinking time per move in milliseconds
+     * @param threads Number of search threads
+     * @param hashMb Size of the transposition table in MiB, for the alpha-beta search
+     */
+    Engine(EngineType type, int64_t moveTimeMs, unsigned threads = 1, size_t hashMb = 16);
+
+    /**
+     * @brief Searches the position and picks a move
+     * @param board Position with the engine to move; must have a legal move
+     * @return Best move found
+     */
+    Move chooseMove(const Board &board);
+
+    /**
+     * @brief Gets the result of the last search
+     * @return Depth, score, nodes (playouts for MCTS), time and principal variation
+     */
+    const SearchInfo &getLastInfo() const { return lastInfo; }
+
+    /**
+     * @brief Gets how much of the last search was carried over from earlier moves
+     * @return For alpha-beta, the fraction of nodes that found a table entry from an earlier
+     *         move; for MCTS, the fraction of the final tree taken over from the last move
+     */
+    double getReusedFraction() const { return reusedFraction; }
+
+    /**
+     * @brief Gets the search type
+     * @return Engine type
+     */
+    EngineType getType() const { return type; }
+
+private:
+    EngineType type;
+    SearchLimits limits;
+    std::unique_ptr<SmpSearch> alphaBeta;
+    std::unique_ptr<Mcts> mcts;
+    SearchInfo lastInfo;
+    double reusedFraction;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef EPD_H
+#define EPD_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct EpdEntry
+ * @brief One position of an EPD test suite
+ */
+struct EpdEntry
+{
+    std::string fen;                     ///< Position as a full FEN string
+    std::string id;                      ///< Value of the "id" operation, if any
+    std::vector<std::string> bestMoves;  ///< SAN moves from the "bm" operation
+    std::vector<std::string> avoidMoves; ///< SAN moves from the "am" operation
+    int mateIn = 0;                      ///< Value of the "dm" (direct mate) operation, 0 if absent
+};
+
+/**
+ * @class Epd
+ * @brief Utility class for reading Extended Position Description files
+ */
+class Epd
+{
+public:
+    /**
+     * @brief Parses a single EPD record
+     * @param line Text of the record (four FEN fields followed by operations)
+     * @param entry Receives the parsed record
+     * @return true if the line holds a record, false for blank, comment or malformed lines
+     */
+    static bool parseLine(const std::string &line, EpdEntry &entry);
+
+    /**
+     * @brief Loads every record from an EPD file
+     * @param path Path of the file to read
+     * @return Parsed records in file order
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    static std::vector<EpdEntry> loadFile(const std::string &path);
+};
+
+#endif
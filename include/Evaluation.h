@@ -0,0 +1,28 @@
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include "Board.h"
+
+/**
+ * @class Evaluation
+ * @brief Utility class for static evaluation of positions in centipawns
+ */
+class Evaluation
+{
+public:
+    /**
+     * @brief Gets the material value of a piece
+     * @param piece Piece to value
+     * @return Value in centipawns (Pawn=100, Knight=320, Bishop=330, Rook=500, Queen=900, King=0)
+     */
+    static int pieceValue(const Piece *piece);
+
+    /**
+     * @brief Evaluates a position from the point of view of the side to move
+     * @param board Reference to the game board
+     * @return Score in centipawns, positive when the side to move is better
+     */
+    static int evaluate(const Board &board);
+};
+
+#endif
@@ -1,11 +1,21 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "Analyzer.h"
+#include "Annotator.h"
 #include "Board.h"
-#include "SpecialMoves.h"
+#include "BoardRenderer.h"
+#include "Coach.h"
+#include "Engine.h"
+#include "InputReader.h"
+#include "MoveGen.h"
 #include "Player.h"
+#include "PgnWriter.h"
+#include <chrono>
+#include <mutex>
 #include <string>
 #include <stdexcept>
+#include <vector>
 
 /**
  * @class Game
@@ -20,6 +30,22 @@ private:
     Player *currentPlayer;
     bool gameOver;
     std::string winner;
+    std::string result;
+    std::vector<MoveRecord> history;
+    PgnWriter *pgnWriter;
+    BoardRenderer renderer;
+    Analyzer analyzer;
+    Engine *engine;
+    Color engineColor;
+    bool review;
+    std::mutex notesMutex;
+    std::vector<std::string> coachNotes;   ///< Coach's remark per ply, filled in as checks finish
+    std::vector<size_t> unshownNotes;      ///< Plies whose remark has not been printed yet
+    Coach coach;                           ///< Declared after the notes so its threads stop first
+    bool coaching;
+    InputReader input;                     ///< Standard input, read by this game only
+    MoveList legalMoves;                   ///< Legal moves of the current position, refreshed after every move
+    std::chrono::steady_clock::time_point turnStart;
 
 public:
     /**
@@ -28,9 +54,17 @@ public:
     Game() : whitePlayer("White", Color::WHITE),
              blackPlayer("Black", Color::BLACK),
              currentPlayer(&whitePlayer),
-             gameOver(false)
+             gameOver(false),
+             result("*"),
+             pgnWriter(nullptr),
+             engine(nullptr),
+             engineColor(Color::BLACK),
+             review(false),
+             coaching(false)
     {
         board.initialize();
+        history.reserve(256);
+        MoveGen::generate(GenType::LEGAL, board, Color::WHITE, legalMoves);
     }
 
     /**
@@ -40,6 +74,8 @@ public:
 
     /**
      * @brief Handles a single turn for the current player
+     * @details Reads one command. The board and prompt are only drawn once no more input
+     *          is waiting, so a line or script of many moves is applied back to back.
      */
     void playTurn();
 
@@ -47,9 +83,37 @@ public:
      * @brief Attempts to make a move from one position to another
      * @param from Source position in chess notation (e.g., "e2")
      * @param to Destination position in chess notation (e.g., "e4")
+     * @param promotion Promotion piece letter for a pawn reaching the last rank; asked for if missing
      * @return true if move was successful, false if invalid
      */
-    bool makeMove(const std::string &from, const std::string &to);
+    bool makeMove(const std::string &from, const std::string &to, char promotion = 0);
+
+    /**
+     * @brief Lets the engine choose and play a move for the current player
+     * @details Prints the move with the search's depth, score, nodes and the share of the
+     *          search carried over from earlier moves.
+     */
+    void playEngineMove();
+
+    /**
+     * @brief Plays a legal move for the current player and passes the turn
+     * @param move Legal move, including castling, en passant and promotion
+     * @param check true to have the coach look at the move, as for moves a player typed
+     */
+    void playMove(const Move &move, bool check = false);
+
+    /**
+     * @brief Ends the current player's move and starts the opponent's turn
+     * @details Charges the time since the turn started to the mover's clock, passes the
+     *          turn, updates the cached legal moves and the game status, then plays the
+     *          new player's premove at once if it is legal. An illegal premove is dropped.
+     */
+    void finishMove();
+
+    /**
+     * @brief Plays the current player's premove if it is among the cached legal moves
+     */
+    void playPremove();
 
     /**
      * @brief Parses a chess notation string into a Position object
@@ -59,10 +123,10 @@ public:
     Position parsePosition(const std::string &pos);
 
     /**
-     * @brief Handles pawn promotion when a pawn reaches the opposite end
-     * @param pos Position of the pawn to promote
+     * @brief Asks the player which piece a pawn reaching the opposite end becomes
+     * @return Uppercase piece letter ('Q', 'R', 'B' or 'N'); Queen for any other input
      */
-    void handlePromotion(const Position &pos);
+    char handlePromotion();
 
     /**
      * @brief Handles castling move
@@ -77,6 +141,7 @@ public:
     void switchPlayer()
     {
         currentPlayer = (currentPlayer == &whitePlayer) ? &blackPlayer : &whitePlayer;
+        board.setSideToMove(currentPlayer->getColor());
     }
 
     /**
@@ -110,16 +175,89 @@ public:
     bool isGameOver() const { return gameOver; }
 
     /**
-     * @brief Checks if a player has any valid moves available
-     * @param color Color of the player to check
-     * @return true if player has at least one legal move, false otherwise
+     * @brief Checks game status and updates gameOver and winner if game ends
+     */
+    void checkGameStatus();
+
+    /**
+     * @brief Appends a move to the game history along with its SAN
+     * @param move Legal move about to be played; the board must not have changed yet
      */
-    bool hasValidMoves(Color color);
+    void recordMove(const Move &move);
 
     /**
-     * @brief Checks game status and updates gameOver and winner if game ends
+     * @brief Gets the moves played so far
+     * @return Move history, starting with White's first move
      */
-    void checkGameStatus();
+    const std::vector<MoveRecord> &getHistory() const { return history; }
+
+    /**
+     * @brief Gets the game result in PGN form
+     * @return "1-0", "0-1", "1/2-1/2", or "*" while the game is in progress
+     */
+    const std::string &getResult() const { return result; }
+
+    /**
+     * @brief Sets where finished games are exported
+     * @param writer PGN writer to append the game to when it ends, or nullptr for none
+     */
+    void setPgnWriter(PgnWriter *writer) { pgnWriter = writer; }
+
+    /**
+     * @brief Hands one side of the board to the computer
+     * @param player Engine to play the side, or nullptr for two human players
+     * @param color Side the engine plays
+     */
+    void setEngine(Engine *player, Color color)
+    {
+        engine = player;
+        engineColor = color;
+    }
+
+    /**
+     * @brief Chooses whether the game is reviewed when it ends
+     * @param enabled true to search every position after the game, list the mistakes and
+     *                blunders, and mark them in the exported PGN
+     */
+    void setReview(bool enabled) { review = enabled; }
+
+    /**
+     * @brief Chooses whether human moves are checked in the background
+     * @param enabled true to look for hanging pieces and missed mates after each move
+     *                entered at the terminal and print what is found on a later turn
+     */
+    void setCoaching(bool enabled);
+
+    /**
+     * @brief Prints the coach's remarks that arrived since the last call
+     */
+    void printCoachNotes();
+
+    /**
+     * @brief Gets the coach's remarks so far
+     * @return One remark per ply, empty where there is none or the check has not finished
+     */
+    std::vector<std::string> getCoachNotes();
+
+    /**
+     * @brief Reviews every move of the game and prints the mistakes and blunders
+     * @return One PGN annotation per move, as made by Annotator::format
+     */
+    std::vector<std::string> reviewGame();
+
+    /**
+     * @brief Chooses how the board is drawn each turn
+     * @param enabled true to keep the board at the top of the terminal and redraw
+     *                only changed squares, false to print a full board every turn
+     */
+    void setAnsiDisplay(bool enabled) { renderer = BoardRenderer(1, enabled); }
+
+    /**
+     * @brief Writes the game with its players, moves and result as PGN
+     * @param writer PGN writer to append the game to
+     * @param annotations NAGs and comments after each move, one per move, or empty for none
+     */
+    void exportPgn(PgnWriter &writer, const std::vector<std::string> &annotations = {}) const;
 };
 
 #endif
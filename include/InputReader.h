@@ -0,0 +1,84 @@
+#ifndef INPUTREADER_H
+#define INPUTREADER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+/**
+ * @class InputReader
+ * @brief Buffered reader of whitespace-separated commands from a file descriptor
+ * @details Reads with one read() per buffer-full and can tell whether more input is
+ *          already waiting, so a caller can hold back its output while a pasted or
+ *          piped sequence of commands is still being processed.
+ */
+class InputReader
+{
+public:
+    /**
+     * @brief Constructs a reader
+     * @param fd File descriptor to read from
+     * @param bufferSize Size of the read buffer in bytes
+     */
+    explicit InputReader(int fd = STDIN_FILENO, size_t bufferSize = 1 << 16);
+
+    InputReader(const InputReader &) = delete;
+    InputReader &operator=(const InputReader &) = delete;
+
+    /**
+     * @brief Reads the next whitespace-separated token, waiting for input if needed
+     * @param token Receives the token
+     * @return false at end of input
+     */
+    bool readToken(std::string &token);
+
+    /**
+     * @brief Reads the rest of the current line, waiting for input if needed
+     * @param line Receives the line without its line break
+     * @return false at end of input
+     */
+    bool readLine(std::string &line);
+
+    /**
+     * @brief Checks, without waiting, whether another token is already available
+     * @return true if a token can be read without blocking
+     */
+    bool hasPending();
+
+    /**
+     * @brief Waits until a read would not block, or until a timeout passes
+     * @param timeoutMs Longest wait in milliseconds; 0 checks without waiting
+     * @return true if input is buffered or readable, the end of input included
+     */
+    bool waitForInput(int timeoutMs);
+
+    /**
+     * @brief Drops whatever is left of the current line, without waiting for more input
+     */
+    void discardLine();
+
+private:
+    int fd;
+    std::unique_ptr<char[]> buffer;
+    size_t capacity;
+    size_t begin;   ///< First unread byte
+    size_t end;     ///< One past the last buffered byte
+    bool eof;
+
+    /**
+     * @brief Reads more input into the buffer
+     * @param wait false to return at once if nothing can be read yet
+     * @return true if at least one byte was added
+     */
+    bool fill(bool wait);
+
+    /**
+     * @brief Skips buffered whitespace, reading more as needed
+     * @param wait false to stop at the end of the buffered input instead of reading
+     * @return true if a non-whitespace byte is now buffered
+     */
+    bool skipSpace(bool wait);
+};
+
+#endif
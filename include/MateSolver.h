@@ -0,0 +1,142 @@
+#ifndef MATESOLVER_H
+#define MATESOLVER_H
+
+#include "Board.h"
+#include "Move.h"
+#include "MoveGen.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct MateLimits
+ * @brief Budget for one mate search; zero means unlimited
+ */
+struct MateLimits
+{
+    int moves = 0;          ///< Longest mate to look for, in moves of the attacker
+    uint64_t nodes = 0;     ///< Maximum number of nodes to expand
+    int64_t timeMs = 0;     ///< Maximum wall-clock time in milliseconds
+    bool checksOnly = true; ///< Only try checking moves for the attacker; misses mates with a quiet move
+};
+
+/**
+ * @struct MateResult
+ * @brief Outcome of a mate search
+ */
+struct MateResult
+{
+    bool proven = false;     ///< The side to move forces mate
+    bool disproven = false;  ///< The side to move cannot force mate (within MateLimits::moves)
+    int mateIn = 0;          ///< Moves of the attacker along line, when proven
+    std::vector<Move> line;  ///< Mating line, attacker and defender alternately, when proven
+    uint64_t nodes = 0;      ///< Nodes expanded
+    int64_t timeMs = 0;      ///< Milliseconds spent
+    int collections = 0;     ///< Times the table was garbage collected
+};
+
+/**
+ * @class MateSolver
+ * @brief Depth-first proof-number (df-pn) search for forced mates
+ * @details By default the attacker only considers checking moves and the defender
+ *          only its evasions, so the tree is far narrower than an alpha-beta tree. Proof and
+ *          disproof numbers live in a fixed-size table; when it fills up, the entries
+ *          that took the least work to compute are dropped (SmallTreeGC), keeping
+ *          proofs, so memory stays bounded however long the search runs.
+ */
+class MateSolver
+{
+public:
+    static const int MAX_PLY = 128;
+
+    /**
+     * @brief Constructs a solver
+     * @param hashMb Size of the proof-number table in MiB
+     */
+    explicit MateSolver(size_t hashMb = 16);
+
+    /**
+     * @brief Looks for a forced mate by the side to move
+     * @param board Position to solve; restored to its original state on return
+     * @param limits Mate length, node and time budget
+     * @return Whether mate was proven or disproven, and the mating line if proven
+     */
+    MateResult solve(Board &board, const MateLimits &limits = MateLimits());
+
+private:
+    /**
+     * @struct Entry
+     * @brief Proof and disproof numbers of one position
+     */
+    struct Entry
+    {
+        uint64_t key;       ///< Position key, 0 for an empty entry
+        uint32_t pn;        ///< Proof number: leaves to expand to prove mate
+        uint32_t dn;        ///< Disproof number: leaves to expand to refute it
+        uint32_t work;      ///< Nodes expanded to compute the numbers
+        uint32_t distance;  ///< Plies to mate when proven
+    };
+
+    /**
+     * @struct Frame
+     * @brief Children of the node being expanded at one ply
+     */
+    struct Frame
+    {
+        MoveList moves;
+        uint64_t keys[MoveList::CAPACITY];
+        uint32_t pn[MoveList::CAPACITY];
+        uint32_t dn[MoveList::CAPACITY];
+        uint32_t distance[MoveList::CAPACITY];
+    };
+
+    std::vector<Entry> table;
+    size_t used;
+    std::unique_ptr<Frame[]> frames;
+    uint64_t path[MAX_PLY + 1];    ///< Zobrist keys of the positions on the current line
+    MateLimits limits;
+    int maxPly;
+    uint64_t nodes;
+    bool aborted;
+    int collections;
+    std::chrono::steady_clock::time_point startTime;
+
+    /**
+     * @brief Expands a node until its numbers reach either threshold (Nagai's MID)
+     * @param board Position of the node; restored on return
+     * @param ply Distance from the root; even plies are the attacker's
+     * @param thresholdPn Proof number threshold
+     * @param thresholdDn Disproof number threshold
+     * @param result Receives the node's proof number, disproof number and mate distance
+     */
+    void expand(Board &board, int ply, uint32_t thresholdPn, uint32_t thresholdDn, Entry &result);
+
+    /**
+     * @brief Gets the table key of a position at a ply
+     * @details With a mate length limit the remaining plies are part of the key, since
+     *          the same position may be provable with more plies left but not with fewer.
+     * @param position Zobrist key of the position
+     * @param ply Distance from the root
+     */
+    uint64_t keyAt(uint64_t position, int ply) const;
+
+    GenType attackerMoves() const { return limits.checksOnly ? GenType::CHECKS : GenType::LEGAL; }
+    bool lookup(uint64_t key, Entry &entry) const;
+    void store(const Entry &entry);
+
+    /**
+     * @brief Frees half the table, dropping the entries that took the least work
+     */
+    void collect();
+
+    /**
+     * @brief Follows the proof from the root, re-proving nodes the collector dropped
+     * @param board Root position; restored on return
+     * @param line Receives the mating line
+     */
+    void extractLine(Board &board, std::vector<Move> &line);
+};
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "Board.h"
+#include "Move.h"
+#include "Search.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class Mcts
+ * @brief Monte Carlo tree search with UCT selection and tree parallelism
+ * @details All threads grow one shared tree. A thread descending through a node
+ *          counts its visit at once, before the result is known, which acts as a
+ *          virtual loss and steers the other threads to different lines. Nodes come
+ *          from a preallocated arena handed out with one atomic add, and every
+ *          counter is atomic, so the tree is never locked. Leaves are valued with
+ *          the static evaluation mapped to a win probability rather than rollouts.
+ *          The tree is kept between searches: when the next position follows from the
+ *          last root by one or two moves, the subtree below it becomes the new root.
+ */
+class Mcts
+{
+public:
+    /**
+     * @brief Constructs a search and its node arena
+     * @param threads Number of threads growing the tree, at least 1
+     * @param nodeCapacity Arena size in nodes; the search stops when it is full
+     */
+    explicit Mcts(unsigned threads = 1, size_t nodeCapacity = 1 << 22);
+
+    /**
+     * @brief Searches the position for the side to move
+     * @param board Position to search; the previous tree is reused if it leads here
+     * @param limits Time budget and, in SearchLimits::nodes, a playout budget; depth is ignored
+     * @return Most visited line; nodes holds the playout count and score the
+     *         root win rate converted to centipawns
+     */
+    SearchInfo run(const Board &board, const SearchLimits &limits);
+
+    /**
+     * @brief Forgets the tree, so the next search starts from an empty one
+     */
+    void clear() { hasTree = false; }
+
+    /**
+     * @brief Asks a running search to stop as soon as possible; safe to call from any thread
+     */
+    void stop() { stopped = true; }
+
+    /**
+     * @brief Gets the number of playouts of the current or last search
+     * @return Playout count
+     */
+    uint64_t getPlayouts() const { return playouts; }
+
+    /**
+     * @brief Gets the number of arena nodes in use
+     * @return Node count
+     */
+    size_t getNodeCount() const { return std::min<size_t>(used, capacity); }
+
+    /**
+     * @brief Gets the number of nodes the last search took over from the one before
+     * @return Node count; zero when the search started from an empty tree
+     */
+    size_t getReusedNodes() const { return reused; }
+
+    /**
+     * @brief Converts a win probability to centipawns, the inverse of the leaf valuation
+     * @param winRate Expected score in [0, 1]
+     * @return Score in centipawns
+     */
+    static int toCentipawns(double winRate);
+
+private:
+    static const int MAX_DEPTH = 256;
+    static const uint32_t VALUE_ONE = 1 << 16;   ///< Fixed-point scale of Node::value
+
+    enum NodeState : uint8_t
+    {
+        UNEXPANDED,
+        EXPANDING,   ///< A thread is generating the children; others treat the node as a leaf
+        EXPANDED
+    };
+
+    /**
+     * @struct Node
+     * @brief One position of the tree, reached by move from its parent
+     */
+    struct Node
+    {
+        Move move;
+        std::atomic<uint8_t> state;
+        uint8_t terminal;               ///< 0, or 1 + value for the side to move in half points
+        uint16_t childCount;
+        uint32_t firstChild;            ///< Arena index of the first of childCount consecutive children
+        std::atomic<uint32_t> visits;   ///< Playouts through the node, including ones still in flight
+        std::atomic<uint64_t> value;    ///< Sum of results for the side that played move, in VALUE_ONE units
+    };
+
+    unsigned threadCount;
+    std::unique_ptr<Node[]> nodes;
+    size_t capacity;
+    std::atomic<size_t> used;
+    std::atomic<bool> stopped;
+    std::atomic<uint64_t> playouts;
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point startTime;
+    Board rootBoard;    ///< Position at the root of the kept tree
+    bool hasTree;
+    size_t reused;
+
+    /**
+     * @brief Grows the tree until stopped; body of every search thread
+     * @param root Position at the root
+     */
+    void work(const Board &root);
+
+    /**
+     * @brief Runs one playout: select, expand, evaluate and back up
+     * @param board Copy of the root position, played forward along the selected line
+     * @return false if the arena is full
+     */
+    bool playout(Board &board);
+
+    /**
+     * @brief Creates the children of a node
+     * @param node Node whose state this thread set to EXPANDING
+     * @param board Position of the node
+     * @return false if the arena is full
+     */
+    bool expand(Node &node, Board &board);
+
+    /**
+     * @brief Picks the child with the highest upper confidence bound
+     * @param node Expanded node with children
+     * @return Selected child
+     */
+    Node &select(Node &node);
+
+    /**
+     * @brief Initializes a node taken from the arena
+     */
+    void reset(Node &node, const Move &move);
+
+    /**
+     * @brief Makes the node for a position up to two plies below the root the new root
+     * @details The subtree is copied breadth first to the front of the arena, which keeps
+     *          every node's children consecutive; everything else is dropped.
+     * @param board Position of the new root
+     * @return Number of nodes kept, or 0 if the position is not in the tree
+     */
+    size_t reroot(const Board &board);
+
+    /**
+     * @brief Copies a node's move, state and statistics; the children are left to the caller
+     */
+    static void copy(Node &to, const Node &from);
+};
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include "Position.h"
+#include <string>
+
+/**
+ * @class Move
+ * @brief Represents a single move from one square to another
+ * @details Castling is encoded as the king moving two squares, en passant as the
+ *          pawn moving onto the en passant target square.
+ */
+class Move
+{
+private:
+    Position from;
+    Position to;
+    char promotion;
+
+public:
+    /**
+     * @brief Constructs a null move
+     */
+    Move() : from(-1, -1), to(-1, -1), promotion(0) {}
+
+    /**
+     * @brief Constructs a move between two positions
+     * @param f Source position
+     * @param t Destination position
+     * @param promo Promotion piece letter ('Q', 'R', 'B', 'N'), or 0 for none
+     */
+    Move(const Position &f, const Position &t, char promo = 0)
+        : from(f), to(t), promotion(promo) {}
+
+    /**
+     * @brief Gets the source position
+     * @return Position the piece moves from
+     */
+    Position getFrom() const { return from; }
+
+    /**
+     * @brief Gets the destination position
+     * @return Position the piece moves to
+     */
+    Position getTo() const { return to; }
+
+    /**
+     * @brief Gets the promotion piece letter
+     * @return Uppercase piece letter, or 0 if the move is not a promotion
+     */
+    char getPromotion() const { return promotion; }
+
+    /**
+     * @brief Checks if this is the null move
+     * @return true if the move has no valid source square
+     */
+    bool isNull() const { return !from.isValid(); }
+
+    /**
+     * @brief Formats the move in UCI coordinate notation
+     * @return String such as "e2e4" or "e7e8q"
+     */
+    std::string toUci() const
+    {
+        if (isNull())
+            return "0000";
+
+        std::string result;
+        result += (char)('a' + from.getCol());
+        result += (char)('0' + (8 - from.getRow()));
+        result += (char)('a' + to.getCol());
+        result += (char)('0' + (8 - to.getRow()));
+        if (promotion)
+            result += (char)(promotion - 'A' + 'a');
+        return result;
+    }
+
+    /**
+     * @brief Equality comparison operator
+     * @param other Move to compare with
+     * @return true if both moves have the same squares and promotion
+     */
+    bool operator==(const Move &other) const
+    {
+        return from == other.from && to == other.to && promotion == other.promotion;
+    }
+
+    /**
+     * @brief Inequality comparison operator
+     * @param other Move to compare with
+     * @return true if the moves differ
+     */
+    bool operator!=(const Move &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @struct MoveRecord
+ * @brief A played move together with its SAN, as kept in a game's history
+ */
+struct MoveRecord
+{
+    Move move;      ///< The move played
+    char san[8];    ///< The move in SAN, NUL-terminated (see Notation::MAX_SAN_LENGTH)
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "Board.h"
+#include "Move.h"
+#include <vector>
+
+/**
+ * @enum GenType
+ * @brief Which moves MoveGen::generate produces
+ */
+enum class GenType
+{
+    CAPTURES,  ///< Pseudo-legal captures (including en passant) and promotions
+    QUIETS,    ///< Pseudo-legal non-captures that do not promote, including castling
+    EVASIONS,  ///< Pseudo-legal moves that may get the side out of check; only valid in check
+    CHECKS,    ///< Legal moves that give check
+    LEGAL      ///< Every legal move
+};
+
+/**
+ * @struct MoveList
+ * @brief Fixed-capacity move list that lives on the stack
+ */
+struct MoveList
+{
+    static const int CAPACITY = 256;  ///< More than the legal moves of any chess position
+
+    Move moves[CAPACITY];
+    int count = 0;
+
+    void push(const Move &move) { moves[count++] = move; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { count = 0; }
+    Move &operator[](int i) { return moves[i]; }
+    const Move &operator[](int i) const { return moves[i]; }
+    Move *begin() { return moves; }
+    Move *end() { return moves + count; }
+    const Move *begin() const { return moves; }
+    const Move *end() const { return moves + count; }
+};
+
+/**
+ * @class MoveGen
+ * @brief Utility class that enumerates moves for a position
+ * @details The generator is instantiated per color and GenType so its inner loops
+ *          contain no branches on either; generate() picks the instance once.
+ */
+class MoveGen
+{
+public:
+    /**
+     * @brief Appends moves of one kind to a list
+     * @param type Which moves to generate
+     * @param board Reference to the game board
+     * @param color Color of the side to generate moves for
+     * @param moves List to append to, with one entry per promotion choice
+     */
+    static void generate(GenType type, Board &board, Color color, MoveList &moves);
+
+    /**
+     * @brief Generates all pseudo-legal moves, ignoring whether the king is left in check
+     * @param board Reference to the game board
+     * @param color Color of the side to generate moves for
+     * @return List of moves, with one entry per promotion choice
+     */
+    static std::vector<Move> generatePseudoLegal(Board &board, Color color);
+
+    /**
+     * @brief Generates all legal moves
+     * @param board Reference to the game board
+     * @param color Color of the side to generate moves for
+     * @return List of moves that do not leave the king in check
+     */
+    static std::vector<Move> generateLegal(Board &board, Color color);
+
+    /**
+     * @brief Generates the legal captures and promotions used by quiescence search
+     * @param board Reference to the game board
+     * @param color Color of the side to generate moves for
+     * @return List of legal captures, en passant captures and promotions
+     */
+    static std::vector<Move> generateCaptures(Board &board, Color color);
+
+    /**
+     * @brief Checks if a pseudo-legal move leaves the mover's king safe
+     * @param board Reference to the game board
+     * @param move Move to test
+     * @return true if the king is not in check after the move, false otherwise
+     */
+    static bool isLegal(Board &board, const Move &move);
+
+    /**
+     * @brief Checks if a move captures a piece (including en passant)
+     * @param board Reference to the game board
+     * @param move Move to test
+     * @return true if the move removes an enemy piece, false otherwise
+     */
+    static bool isCapture(const Board &board, const Move &move);
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include "Board.h"
+#include "Move.h"
+#include <cstddef>
+#include <string>
+
+/**
+ * @class Notation
+ * @brief Utility class for converting moves to and from text notations
+ */
+class Notation
+{
+public:
+    /**
+     * @brief Longest possible SAN string, e.g. "Qa1xb2#" or "exd8=Q+"
+     */
+    static const size_t MAX_SAN_LENGTH = 7;
+
+    /**
+     * @brief Formats a legal move in Standard Algebraic Notation
+     * @param board Reference to the game board, positioned before the move
+     * @param move Legal move for the side to move
+     * @return SAN string such as "Nbd7", "exd5", "O-O" or "e8=Q#"
+     */
+    static std::string toSan(Board &board, const Move &move);
+
+    /**
+     * @brief Writes a legal move in Standard Algebraic Notation into a caller buffer
+     * @param board Reference to the game board, positioned before the move
+     * @param move Legal move for the side to move
+     * @param out Buffer of at least MAX_SAN_LENGTH + 1 characters; receives a NUL-terminated string
+     * @return Number of characters written, excluding the terminator
+     */
+    static size_t writeSan(Board &board, const Move &move, char *out);
+
+    /**
+     * @brief Parses a move in Standard Algebraic Notation
+     * @param board Reference to the game board, positioned before the move
+     * @param san SAN text; check marks and annotation glyphs are ignored
+     * @return The matching legal move, or a null move if none matches
+     */
+    static Move fromSan(Board &board, const std::string &san);
+
+    /**
+     * @brief Parses a move in UCI coordinate notation
+     * @param board Reference to the game board, positioned before the move
+     * @param uci Coordinate text such as "e2e4" or "e7e8q"
+     * @return The matching legal move, or a null move if none matches
+     */
+    static Move fromUci(Board &board, const std::string &uci);
+
+    /**
+     * @brief Removes check marks and annotation glyphs from a SAN token
+     * @param san SAN text such as "Qxf7+!" or "O-O#"
+     * @return The bare move text, with castling written with the letter O
+     */
+    static std::string stripSan(const std::string &san);
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct NumaNode
+ * @brief One memory node and the CPUs attached to it
+ */
+struct NumaNode
+{
+    int id = 0;                ///< Kernel node number
+    std::vector<int> cpus;     ///< CPUs local to this node
+};
+
+/**
+ * @class Numa
+ * @brief Utility class for NUMA topology, thread placement and memory policy
+ * @details The topology is read once from /sys/devices/system/node. When that is
+ *          missing, or there is only one node, the machine is treated as a single
+ *          node and pinning and memory binding do nothing.
+ */
+class Numa
+{
+public:
+    /**
+     * @brief Gets the memory nodes of the machine
+     * @return At least one node; a single node holding every CPU if sysfs has no topology
+     */
+    static const std::vector<NumaNode> &nodes();
+
+    /**
+     * @brief Checks if placement can make a difference
+     * @return true if the machine has more than one node with CPUs
+     */
+    static bool isMultiNode() { return nodes().size() > 1; }
+
+    /**
+     * @brief Chooses the node for one of several worker threads
+     * @param index Worker index (0 to threads - 1)
+     * @param threads Number of workers
+     * @return Position in nodes() of the node to run on; workers are split into equal consecutive blocks
+     */
+    static int nodeForThread(unsigned index, unsigned threads);
+
+    /**
+     * @brief Restricts the calling thread to the CPUs of a node
+     * @param node Position in nodes()
+     * @return true if the thread was pinned, false on a single-node machine or on failure
+     */
+    static bool pinThread(int node);
+
+    /**
+     * @brief Places pages of a memory range on one node
+     * @details Only pages not yet touched are affected, so call this right after mapping.
+     * @param memory Page-aligned start of the range
+     * @param bytes Length of the range
+     * @param node Position in nodes()
+     * @return true on success, false on a single-node machine or on failure
+     */
+    static bool bindMemory(void *memory, size_t bytes, int node);
+
+    /**
+     * @brief Spreads pages of a memory range round-robin over all nodes
+     * @param memory Page-aligned start of the range
+     * @param bytes Length of the range
+     * @return true on success, false on a single-node machine or on failure
+     */
+    static bool interleaveMemory(void *memory, size_t bytes);
+};
+
+#endif
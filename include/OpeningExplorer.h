@@ -0,0 +1,142 @@
+#ifndef OPENINGEXPLORER_H
+#define OPENINGEXPLORER_H
+
+#include "Board.h"
+#include "Move.h"
+#include "Pgn.h"
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct MoveStats
+ * @brief Aggregated results of one move played from a position
+ */
+struct MoveStats
+{
+    Move move;                ///< The move played
+    std::string san;          ///< The move in SAN
+    uint32_t games = 0;       ///< Number of games in which it was played
+    uint32_t whiteWins = 0;   ///< Games won by White
+    uint32_t draws = 0;       ///< Games drawn
+    uint32_t blackWins = 0;   ///< Games won by Black
+    uint64_t ratingSum = 0;   ///< Sum of average player ratings over rated games
+    uint32_t ratedGames = 0;  ///< Games in which both players had a rating
+
+    /**
+     * @brief Gets the average rating of the players who reached this move
+     * @return Mean rating, or 0 if no game was rated
+     */
+    int averageRating() const { return ratedGames ? (int)(ratingSum / ratedGames) : 0; }
+};
+
+/**
+ * @class OpeningExplorer
+ * @brief Answers "what was played here, and how did it score" from a game database
+ * @details Positions within the first few plies are aggregated while games are added,
+ *          since they are shared by most of the database. Deeper positions keep a
+ *          Zobrist-keyed list of (game, ply) occurrences that is aggregated on demand
+ *          and kept in an LRU cache.
+ */
+class OpeningExplorer
+{
+private:
+    struct GameRecord
+    {
+        std::vector<Move> moves;
+        char result;        // 'W', 'D', 'B' or '*'
+        uint16_t rating;    // Average of both players' ratings, 0 if unknown
+    };
+
+    struct Occurrence
+    {
+        uint32_t game;
+        uint16_t ply;
+    };
+
+    using StatsList = std::vector<MoveStats>;
+    using CacheList = std::list<std::pair<uint64_t, StatsList>>;
+
+    int precomputedPlies;
+    size_t cacheCapacity;
+    std::vector<GameRecord> games;
+    std::unordered_map<uint64_t, StatsList> precomputed;
+    std::unordered_map<uint64_t, std::vector<Occurrence>> occurrences;
+    CacheList cache;
+    std::unordered_map<uint64_t, CacheList::iterator> cacheIndex;
+
+    /**
+     * @brief Adds one game's result to the statistics of a move
+     * @param stats Statistics list of the position the move was played from
+     * @param move The move played
+     * @param record The game the move was played in
+     */
+    static void accumulate(StatsList &stats, const Move &move, const GameRecord &record);
+
+    /**
+     * @brief Fills in the SAN of moves that have not been named yet
+     * @param stats Statistics list of the position
+     * @param board Board positioned at that position
+     */
+    static void nameMoves(StatsList &stats, Board &board);
+
+    /**
+     * @brief Aggregates the stored occurrences of a deep position
+     * @param list Occurrences of the position
+     * @return Statistics for every move played from it
+     */
+    StatsList aggregate(const std::vector<Occurrence> &list) const;
+
+    /**
+     * @brief Gets the aggregate of a deep position through the LRU cache
+     * @param key Zobrist key of the position
+     * @param list Occurrences of the position
+     * @param board Board positioned at that position
+     * @return Reference to the cached statistics
+     */
+    const StatsList &cachedAggregate(uint64_t key, const std::vector<Occurrence> &list, Board &board);
+
+public:
+    /**
+     * @brief Constructs an empty explorer
+     * @param plies Number of plies from the start whose positions are aggregated up front
+     * @param capacity Maximum number of deep positions kept in the LRU cache
+     */
+    explicit OpeningExplorer(int plies = 16, size_t capacity = 4096);
+
+    /**
+     * @brief Replays a game from the standard starting position and indexes it
+     * @param game Parsed PGN game
+     * @return true if every move was legal, false if the game was skipped
+     */
+    bool addGame(const PgnGame &game);
+
+    /**
+     * @brief Folds deep occurrences of precomputed positions into their aggregates
+     * @details Call once after adding games so queries near the root become pure lookups.
+     */
+    void finalize();
+
+    /**
+     * @brief Gets every move played from a position, most popular first
+     * @param board Board positioned at the position to query
+     * @return Move statistics, empty if the position is not in the database
+     */
+    std::vector<MoveStats> query(Board &board);
+
+    /**
+     * @brief Gets the number of indexed games
+     * @return Game count
+     */
+    size_t getGameCount() const { return games.size(); }
+
+    /**
+     * @brief Gets the number of positions with precomputed statistics
+     * @return Position count
+     */
+    size_t getPrecomputedCount() const { return precomputed.size(); }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Gets the default number of worker threads
+ * @return Number of hardware threads, at least 1
+ */
+inline unsigned defaultThreadCount()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Calls a function for every index in [0, count) across several threads
+ * @details Workers pull the next index from a shared counter, so uneven work
+ *          per index is balanced automatically.
+ * @tparam Function Callable taking a size_t index
+ * @param count Number of indices
+ * @param threads Maximum number of threads to use
+ * @param function Function to call for each index
+ */
+template <typename Function>
+void parallelFor(size_t count, unsigned threads, Function function)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < count; i = next++)
+        {
+            function(i);
+        }
+    };
+
+    threads = (unsigned)std::min<size_t>(std::max(1u, threads), std::max<size_t>(1, count));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread &thread : pool)
+        thread.join();
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef PGN_H
+#define PGN_H
+
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct PgnGame
+ * @brief Tags, main-line moves and result of one game in Portable Game Notation
+ */
+struct PgnGame
+{
+    std::vector<std::pair<std::string, std::string>> tags; ///< Tag pairs in file order
+    std::vector<std::string> moves;                        ///< Main-line SAN moves
+    std::string result = "*";                              ///< "1-0", "0-1", "1/2-1/2" or "*"
+    std::string text;                                      ///< Original text of the game
+
+    /**
+     * @brief Gets the value of a tag
+     * @param name Tag name such as "White" or "WhiteElo"
+     * @return Tag value, or an empty string if the tag is missing
+     */
+    std::string getTag(const std::string &name) const;
+};
+
+/**
+ * @class PgnReader
+ * @brief Streams games one at a time out of a PGN file
+ * @details Comments, variations, NAGs and move numbers are skipped; only the
+ *          main line is returned.
+ */
+class PgnReader
+{
+private:
+    std::istream &input;
+    std::string pendingLine;
+    bool hasPendingLine;
+
+    /**
+     * @brief Reads the next line, returning a line pushed back by the previous game first
+     * @param line Receives the line without its terminator
+     * @return true if a line was read, false at end of input
+     */
+    bool readLine(std::string &line);
+
+public:
+    /**
+     * @brief Constructs a reader over a stream
+     * @param in Stream positioned at the start of PGN text
+     */
+    explicit PgnReader(std::istream &in) : input(in), hasPendingLine(false) {}
+
+    /**
+     * @brief Reads the next game
+     * @param game Receives the parsed game
+     * @return true if a game was read, false at end of input
+     */
+    bool next(PgnGame &game);
+};
+
+#endif
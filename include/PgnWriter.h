@@ -0,0 +1,108 @@
+#ifndef PGNWRITER_H
+#define PGNWRITER_H
+
+#include "Move.h"
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct PgnHeader
+ * @brief The Seven Tag Roster written in front of every exported game
+ */
+struct PgnHeader
+{
+    std::string event = "Casual Game";
+    std::string site = "CLI Chess";
+    std::string date;           ///< "YYYY.MM.DD"; today's date if left empty
+    std::string round = "-";
+    std::string white = "White";
+    std::string black = "Black";
+    std::string result = "*";   ///< "1-0", "0-1", "1/2-1/2" or "*"
+    std::string fen;            ///< Starting position, written with a SetUp tag; empty for the usual one
+};
+
+/**
+ * @class PgnWriter
+ * @brief Appends finished games to a PGN file through a large in-memory buffer
+ * @details Games are formatted straight into the buffer and the file only sees
+ *          one write per buffer-full, so many games per second can be appended
+ *          to a single file. writeGame may be called from several threads.
+ */
+class PgnWriter
+{
+private:
+    std::FILE *file;
+    std::unique_ptr<char[]> buffer;
+    size_t capacity;
+    size_t used;
+    std::mutex mutex;
+
+    /**
+     * @brief Copies bytes into the buffer, writing the buffer out whenever it fills
+     * @param data Bytes to append
+     * @param length Number of bytes
+     */
+    void append(const char *data, size_t length);
+
+    /**
+     * @brief Appends a tag pair line such as [White "Alice"]
+     * @param name Tag name
+     * @param value Tag value; quotes and backslashes are escaped
+     */
+    void appendTag(const char *name, const std::string &value);
+
+    /**
+     * @brief Writes the buffer to the file; the caller must hold the mutex
+     */
+    void flushLocked();
+
+public:
+    /**
+     * @brief Opens a PGN file for appending
+     * @param path File to append to; created if missing
+     * @param bufferSize Size of the write buffer in bytes
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit PgnWriter(const std::string &path, size_t bufferSize = 1 << 20);
+
+    /**
+     * @brief Flushes buffered games and closes the file
+     */
+    ~PgnWriter();
+
+    PgnWriter(const PgnWriter &) = delete;
+    PgnWriter &operator=(const PgnWriter &) = delete;
+
+    /**
+     * @brief Appends one game
+     * @param header Tags to write; header.result is also written after the moves
+     * @param moves Moves of the game in order, starting with White's first move
+     * @param count Number of moves
+     * @param annotations Optional NAGs and comments to write after each move, count of them
+     */
+    void writeGame(const PgnHeader &header, const MoveRecord *moves, size_t count,
+                   const std::string *annotations = nullptr);
+
+    /**
+     * @brief Appends one game
+     * @param header Tags to write; header.result is also written after the moves
+     * @param moves Moves of the game in order, starting with White's first move
+     * @param annotations NAGs and comments to write after each move, one per move, or empty for none
+     */
+    void writeGame(const PgnHeader &header, const std::vector<MoveRecord> &moves,
+                   const std::vector<std::string> &annotations = {})
+    {
+        writeGame(header, moves.data(), moves.size(), annotations.empty() ? nullptr : annotations.data());
+    }
+
+    /**
+     * @brief Writes buffered games to the file
+     */
+    void flush();
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define PIECES_H
 
 #include "Position.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
@@ -10,46 +11,170 @@
  * @enum Color
  * @brief Represents the two colors in chess
  */
-enum class Color
+enum class Color : uint8_t
 {
     WHITE,
     BLACK
 };
 
+/**
+ * @enum PieceType
+ * @brief The six kinds of chess piece, in the order used by every piece table
+ */
+enum class PieceType : uint8_t
+{
+    PAWN,
+    KNIGHT,
+    BISHOP,
+    ROOK,
+    QUEEN,
+    KING
+};
+
+/**
+ * @brief Number of piece types
+ */
+const int PIECE_TYPE_COUNT = 6;
+
+/**
+ * @brief Uppercase FEN letter of each piece type
+ */
+constexpr char PIECE_LETTERS[] = "PNBRQK";
+
+/**
+ * @brief Material value of each piece type in centipawns, as used by the evaluation
+ */
+constexpr int MATERIAL_VALUES[PIECE_TYPE_COUNT] = {100, 320, 330, 500, 900, 0};
+
+/**
+ * @brief Value of each piece type for exchange evaluation and capture ordering
+ */
+constexpr int SEE_VALUES[PIECE_TYPE_COUNT] = {100, 300, 300, 500, 900, 10000};
+
+/**
+ * @brief Unicode glyph of each piece type, indexed by [color][type]
+ */
+constexpr const char *PIECE_GLYPHS[2][PIECE_TYPE_COUNT] = {
+    {"♙", "♘", "♗", "♖", "♕", "♔"},
+    {"♟", "♞", "♝", "♜", "♛", "♚"}};
+
+/**
+ * @brief English name of each piece type
+ */
+constexpr const char *PIECE_NAMES[PIECE_TYPE_COUNT] = {"Pawn", "Knight", "Bishop", "Rook", "Queen", "King"};
+
+/**
+ * @brief Gets the material value of a piece type
+ * @param type Piece type
+ * @return Value in centipawns; 0 for the king
+ */
+constexpr int materialValue(PieceType type) { return MATERIAL_VALUES[(int)type]; }
+
+/**
+ * @brief Gets the exchange value of a piece type
+ * @param type Piece type
+ * @return Value in centipawns; the king outweighs everything else
+ */
+constexpr int seeValue(PieceType type) { return SEE_VALUES[(int)type]; }
+
+/**
+ * @brief Gets the FEN letter of a piece
+ * @param type Piece type
+ * @param color Piece color
+ * @return Uppercase letter for White, lowercase for Black
+ */
+constexpr char fenLetter(PieceType type, Color color)
+{
+    return (char)(PIECE_LETTERS[(int)type] + (color == Color::WHITE ? 0 : 'a' - 'A'));
+}
+
+/**
+ * @brief Gets the Unicode glyph of a piece
+ * @param type Piece type
+ * @param color Piece color
+ * @return UTF-8 glyph in static storage
+ */
+constexpr const char *pieceGlyph(PieceType type, Color color) { return PIECE_GLYPHS[(int)color][(int)type]; }
+
+/**
+ * @brief Gets the table index of a piece letter
+ * @param letter Uppercase piece letter
+ * @return 0 (Pawn) to 5 (King), or -1 for an unknown letter
+ */
+constexpr int pieceTypeIndex(char letter)
+{
+    switch (letter)
+    {
+    case 'P':
+        return 0;
+    case 'N':
+        return 1;
+    case 'B':
+        return 2;
+    case 'R':
+        return 3;
+    case 'Q':
+        return 4;
+    case 'K':
+        return 5;
+    default:
+        return -1;
+    }
+}
+
 /**
  * @class Piece
  * @brief Abstract base class for all chess pieces
+ * @details Pieces hold no per-square state, so one shared instance exists per piece
+ *          type and color (see Piece::get). The Board stores which piece stands
+ *          where; everything about a particular move is passed in as arguments.
  */
 class Piece
 {
 protected:
     Color color;
-    Position position;
-    bool hasMoved;
-    char symbol;
+    PieceType type;
 
 public:
     /**
      * @brief Constructs a Piece with specified attributes
      * @param c Color of the piece (WHITE or BLACK)
-     * @param pos Initial position on the board
-     * @param sym Symbol character for the piece (uppercase)
+     * @param t Type of the piece
      */
-    Piece(Color c, Position pos, char sym)
-        : color(c), position(pos), hasMoved(false), symbol(sym) {}
+    constexpr Piece(Color c, PieceType t) : color(c), type(t) {}
 
     /**
      * @brief Virtual destructor for proper polymorphic destruction
      */
     virtual ~Piece() = default;
 
+    Piece(const Piece &) = delete;
+    Piece &operator=(const Piece &) = delete;
+
+    /**
+     * @brief Gets the shared instance for a piece type and color
+     * @param letter Uppercase piece letter ('P', 'N', 'B', 'R', 'Q', 'K')
+     * @param color Color of the piece
+     * @return Pointer to the shared piece, or nullptr for an unknown letter
+     */
+    static const Piece *get(char letter, Color color);
+
+    /**
+     * @brief Gets the shared instance for a piece type and color
+     * @param type Piece type
+     * @param color Color of the piece
+     * @return Pointer to the shared piece
+     */
+    static const Piece *get(PieceType type, Color color);
+
     /**
      * @brief Pure virtual function to validate piece movement
+     * @param from Square the piece stands on
      * @param to Destination position
      * @param board Reference to the game board
      * @return true if the move is valid according to piece rules, false otherwise
      */
-    virtual bool isValidMove(const Position &to, const class Board &board) const = 0;
+    virtual bool isValidMove(const Position &from, const Position &to, const class Board &board) const = 0;
 
     /**
      * @brief Gets the display symbol for the piece
@@ -58,44 +183,34 @@ public:
     virtual std::string getSymbol() const;
 
     /**
-     * @brief Pure virtual function to get piece name
-     * @return String name of the piece type
+     * @brief Gets the display symbol without allocating
+     * @return UTF-8 chess piece glyph in static storage
      */
-    virtual std::string getName() const = 0;
+    const char *getGlyph() const { return pieceGlyph(type, color); }
 
     /**
-     * @brief Gets the color of the piece
-     * @return Color enum value (WHITE or BLACK)
-     */
-    Color getColor() const { return color; }
-
-    /**
-     * @brief Gets the current position of the piece
-     * @return Position object representing current location
+     * @brief Gets the piece name
+     * @return String name of the piece type
      */
-    Position getPosition() const { return position; }
+    std::string getName() const { return PIECE_NAMES[(int)type]; }
 
     /**
-     * @brief Sets the position and marks piece as moved
-     * @param pos New position for the piece
+     * @brief Gets the piece type
+     * @return PieceType enum value
      */
-    void setPosition(const Position &pos)
-    {
-        position = pos;
-        hasMoved = true;
-    }
+    PieceType getType() const { return type; }
 
     /**
-     * @brief Checks if the piece has moved from its initial position
-     * @return true if piece has moved, false otherwise
+     * @brief Gets the piece letter used in FEN and algebraic notation
+     * @return Uppercase letter for the piece type ('P', 'N', 'B', 'R', 'Q', 'K')
      */
-    bool hasMovedBefore() const { return hasMoved; }
+    char getLetter() const { return PIECE_LETTERS[(int)type]; }
 
     /**
-     * @brief Sets the movement status of the piece
-     * @param moved Boolean indicating if piece has moved
+     * @brief Gets the color of the piece
+     * @return Color enum value (WHITE or BLACK)
      */
-    void setHasMoved(bool moved) { hasMoved = moved; }
+    Color getColor() const { return color; }
 
     /**
      * @brief Template function for runtime type checking
@@ -119,11 +234,9 @@ public:
     /**
      * @brief Constructs a Pawn piece
      * @param c Color of the pawn
-     * @param pos Initial position
      */
-    Pawn(Color c, Position pos) : Piece(c, pos, 'P') {}
-    bool isValidMove(const Position &to, const class Board &board) const override;
-    std::string getName() const override { return "Pawn"; }
+    constexpr explicit Pawn(Color c) : Piece(c, PieceType::PAWN) {}
+    bool isValidMove(const Position &from, const Position &to, const class Board &board) const override;
 };
 
 /**
@@ -136,11 +249,9 @@ public:
     /**
      * @brief Constructs a Rook piece
      * @param c Color of the rook
-     * @param pos Initial position
      */
-    Rook(Color c, Position pos) : Piece(c, pos, 'R') {}
-    bool isValidMove(const Position &to, const class Board &board) const override;
-    std::string getName() const override { return "Rook"; }
+    constexpr explicit Rook(Color c) : Piece(c, PieceType::ROOK) {}
+    bool isValidMove(const Position &from, const Position &to, const class Board &board) const override;
 };
 
 /**
@@ -153,11 +264,9 @@ public:
     /**
      * @brief Constructs a Knight piece
      * @param c Color of the knight
-     * @param pos Initial position
      */
-    Knight(Color c, Position pos) : Piece(c, pos, 'N') {}
-    bool isValidMove(const Position &to, const class Board &board) const override;
-    std::string getName() const override { return "Knight"; }
+    constexpr explicit Knight(Color c) : Piece(c, PieceType::KNIGHT) {}
+    bool isValidMove(const Position &from, const Position &to, const class Board &board) const override;
 };
 
 /**
@@ -170,11 +279,9 @@ public:
     /**
      * @brief Constructs a Bishop piece
      * @param c Color of the bishop
-     * @param pos Initial position
      */
-    Bishop(Color c, Position pos) : Piece(c, pos, 'B') {}
-    bool isValidMove(const Position &to, const class Board &board) const override;
-    std::string getName() const override { return "Bishop"; }
+    constexpr explicit Bishop(Color c) : Piece(c, PieceType::BISHOP) {}
+    bool isValidMove(const Position &from, const Position &to, const class Board &board) const override;
 };
 
 /**
@@ -187,11 +294,9 @@ public:
     /**
      * @brief Constructs a Queen piece
      * @param c Color of the queen
-     * @param pos Initial position
      */
-    Queen(Color c, Position pos) : Piece(c, pos, 'Q') {}
-    bool isValidMove(const Position &to, const class Board &board) const override;
-    std::string getName() const override { return "Queen"; }
+    constexpr explicit Queen(Color c) : Piece(c, PieceType::QUEEN) {}
+    bool isValidMove(const Position &from, const Position &to, const class Board &board) const override;
 };
 
 /**
@@ -204,11 +309,9 @@ public:
     /**
      * @brief Constructs a King piece
      * @param c Color of the king
-     * @param pos Initial position
      */
-    King(Color c, Position pos) : Piece(c, pos, 'K') {}
-    bool isValidMove(const Position &to, const class Board &board) const override;
-    std::string getName() const override { return "King"; }
+    constexpr explicit King(Color c) : Piece(c, PieceType::KING) {}
+    bool isValidMove(const Position &from, const Position &to, const class Board &board) const override;
 };
 
 #endif
\ No newline at end of file
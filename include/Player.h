@@ -1,7 +1,9 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
+#include "Move.h"
 #include "Pieces.h"
+#include <cstdint>
 #include <string>
 
 /**
@@ -16,6 +18,8 @@ private:
     bool isInCheck;
     int score;
     int capturedPieceValue;
+    Move premove;       ///< Move to play the instant the opponent has moved, or a null move
+    int64_t clockMs;    ///< Thinking time used so far
 
 public:
     /**
@@ -120,6 +124,36 @@ public:
      */
     bool isBlack() const;
 
+    /**
+     * @brief Queues a move to try as soon as the opponent has moved, replacing any earlier one
+     * @param move Move to try; checked only when it is played
+     */
+    void setPremove(const Move &move);
+
+    /**
+     * @brief Checks if a premove is queued
+     * @return true if a premove is waiting
+     */
+    bool hasPremove() const;
+
+    /**
+     * @brief Removes the queued premove
+     * @return The premove, or a null move if there was none
+     */
+    Move takePremove();
+
+    /**
+     * @brief Gets the thinking time used so far
+     * @return Time in milliseconds
+     */
+    int64_t getClockMs() const;
+
+    /**
+     * @brief Charges thinking time to the player
+     * @param ms Time in milliseconds
+     */
+    void addClockMs(int64_t ms);
+
     /**
      * @brief Resets player state for a new game
      */
@@ -1,17 +1,19 @@
 #ifndef POSITION_H
 #define POSITION_H
 
+#include "Square.h"
 #include <iostream>
 
 /**
  * @class Position
  * @brief Represents a position on the chess board using row and column coordinates
+ * @details Stored as a single Square byte; coordinates off the board all map to
+ *          NO_SQUARE, so validity is one comparison.
  */
 class Position
 {
 private:
-    int row;
-    int col;
+    Square square;
 
 public:
     /**
@@ -19,31 +21,49 @@ public:
      * @param r Row index (0-7, where 0 is top row/rank 8)
      * @param c Column index (0-7, where 0 is left column/file 'a')
      */
-    Position(int r = 0, int c = 0) : row(r), col(c) {}
+    Position(int r = 0, int c = 0) : square(makeSquare(r, c)) {}
+
+    /**
+     * @brief Constructs a Position from a square index
+     * @param sq Square index (row * 8 + col), or NO_SQUARE
+     * @return Position of that square
+     */
+    static Position fromSquare(Square sq)
+    {
+        Position pos;
+        pos.square = sq;
+        return pos;
+    }
+
+    /**
+     * @brief Gets the square index
+     * @return row * 8 + col, or NO_SQUARE if off the board
+     */
+    Square getSquare() const { return square; }
 
     /**
      * @brief Gets the row index
      * @return Row index (0-7)
      */
-    int getRow() const { return row; }
+    int getRow() const { return rowOf(square); }
 
     /**
      * @brief Gets the column index
      * @return Column index (0-7)
      */
-    int getCol() const { return col; }
+    int getCol() const { return colOf(square); }
 
     /**
      * @brief Sets the row index
      * @param r Row index (0-7)
      */
-    void setRow(int r) { row = r; }
+    void setRow(int r) { square = makeSquare(r, getCol()); }
 
     /**
      * @brief Sets the column index
      * @param c Column index (0-7)
      */
-    void setCol(int c) { col = c; }
+    void setCol(int c) { square = makeSquare(getRow(), c); }
 
     /**
      * @brief Validates if the position is within board bounds
@@ -51,7 +71,7 @@ public:
      */
     bool isValid() const
     {
-        return row >= 0 && row < 8 && col >= 0 && col < 8;
+        return square < NO_SQUARE;
     }
 
     /**
@@ -61,7 +81,7 @@ public:
      */
     bool operator==(const Position &other) const
     {
-        return row == other.row && col == other.col;
+        return square == other.square;
     }
 
     /**
@@ -82,7 +102,7 @@ public:
      */
     friend std::ostream &operator<<(std::ostream &os, const Position &pos)
     {
-        os << (char)('a' + pos.col) << (8 - pos.row);
+        os << (char)('a' + pos.getCol()) << (8 - pos.getRow());
         return os;
     }
 };
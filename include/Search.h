@@ -0,0 +1,156 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "Board.h"
+#include "Move.h"
+#include "MoveGen.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct SearchLimits
+ * @brief Budget for a single search; zero means unlimited
+ */
+struct SearchLimits
+{
+    int depth = 64;         ///< Maximum iterative deepening depth
+    uint64_t nodes = 0;     ///< Maximum number of nodes to visit
+    int64_t timeMs = 0;     ///< Maximum wall-clock time in milliseconds
+};
+
+/**
+ * @struct SearchInfo
+ * @brief Result of a completed search iteration
+ */
+struct SearchInfo
+{
+    int depth = 0;          ///< Depth of the completed iteration
+    int score = 0;          ///< Score in centipawns from the side to move's point of view
+    uint64_t nodes = 0;     ///< Nodes searched so far
+    int64_t timeMs = 0;     ///< Milliseconds elapsed since the search started
+    std::vector<Move> pv;   ///< Principal variation, starting with the best move
+
+    /**
+     * @brief Gets the best move found
+     * @return First move of the principal variation, or a null move
+     */
+    Move bestMove() const { return pv.empty() ? Move() : pv.front(); }
+};
+
+/**
+ * @class Search
+ * @brief Iterative deepening alpha-beta search with quiescence
+ * @details One Search object searches one position at a time; run several objects
+ *          on separate boards to search in parallel. Each object preallocates one
+ *          frame per ply, so the search itself never touches the heap.
+ */
+class Search
+{
+public:
+    static const int INFINITE_SCORE = 32000;
+    static const int MATE_SCORE = 31000;
+    static const int MAX_PLY = 64;
+
+    /**
+     * @brief Constructs an idle search
+     */
+    Search();
+
+    /**
+     * @brief Searches the position for the side to move
+     * @param board Board to search; restored to its original state on return
+     * @param limits Depth, node and time budget
+     * @param onIteration Optional callback invoked after every completed iteration
+     * @return Information about the deepest completed iteration
+     */
+    SearchInfo run(Board &board, const SearchLimits &limits,
+                   const std::function<void(const SearchInfo &)> &onIteration = nullptr);
+
+    /**
+     * @brief Chooses how the search walks the tree
+     * @param enabled true to search a copy of the board after each move (copy-make),
+     *                false to make and unmake moves on a single board
+     */
+    void setCopyMake(bool enabled) { copyMake = enabled; }
+
+    /**
+     * @brief Sets the transposition table the search reads and writes
+     * @param tt Table to use, possibly shared with other searches, or nullptr for none
+     */
+    void setTable(TranspositionTable *tt) { table = tt; }
+
+    /**
+     * @brief Makes the search also stop when an outside flag is raised
+     * @details Unlike stop(), the flag is not reset when a search starts, so it also
+     *          stops searches that have not begun yet.
+     * @param flag Flag to watch, or nullptr for none
+     */
+    void setSharedStop(const std::atomic<bool> *flag) { sharedStop = flag; }
+
+    /**
+     * @brief Asks a running search to stop as soon as possible; safe to call from any thread
+     */
+    void stop() { stopped = true; }
+
+    /**
+     * @brief Gets the number of nodes visited by the current or last search
+     * @return Node count
+     */
+    uint64_t getNodes() const { return nodes; }
+
+    /**
+     * @brief Gets the number of nodes of the current or last search that found an entry
+     *        stored by an earlier search in the transposition table
+     * @return Node count
+     */
+    uint64_t getReusedNodes() const { return reusedNodes; }
+
+    /**
+     * @brief Checks if a score represents a forced mate
+     * @param score Score returned by the search
+     * @return true if the score is within MAX_PLY of a mate score
+     */
+    static bool isMateScore(int score) { return score > MATE_SCORE - MAX_PLY || score < -MATE_SCORE + MAX_PLY; }
+
+private:
+    /**
+     * @struct Frame
+     * @brief Working storage for one ply of the search
+     */
+    struct Frame
+    {
+        MoveList moves;                    ///< Moves generated at this ply
+        int scores[MoveList::CAPACITY];    ///< Ordering score of each move
+        Move killers[2];                   ///< Quiet moves that last caused a beta cutoff at this ply
+        int staticEval;                    ///< Stand-pat evaluation, set by quiescence only
+        Move pv[MAX_PLY];                  ///< Principal variation from this ply on
+        int pvLength;                      ///< Number of moves in pv
+    };
+
+    std::atomic<bool> stopped;
+    const std::atomic<bool> *sharedStop;
+    TranspositionTable *table;
+    bool copyMake;
+    SearchLimits limits;
+    uint64_t nodes;
+    uint64_t reusedNodes;
+    int rootDepth;
+    std::chrono::steady_clock::time_point startTime;
+    std::unique_ptr<Frame[]> frames;    ///< One frame per ply, allocated once
+    Move previousPv[MAX_PLY];
+    int previousPvLength;
+
+    int negamax(Board &board, int depth, int ply, int alpha, int beta);
+    int quiescence(Board &board, int ply, int alpha, int beta);
+    void scoreMoves(const Board &board, Frame &frame, int ply, const Move &ttMove) const;
+    const Move &pickMove(Frame &frame, int index) const;
+    bool checkLimits();
+    int64_t elapsedMs() const;
+};
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef SESSIONMANAGER_H
+#define SESSIONMANAGER_H
+
+#include "Board.h"
+#include "Move.h"
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct PackedGame
+ * @brief A hibernated game: its starting position and one byte per move played
+ * @details Each move is stored as its index among the legal moves MoveGen produces
+ *          for the position it was played in, so the bytes are only meaningful
+ *          together with the starting position and the same move generator.
+ */
+struct PackedGame
+{
+    PackedPosition start;  ///< Position the game started from
+    std::string moves;     ///< Legal-move index of every ply
+};
+
+/**
+ * @class Session
+ * @brief One open game in server mode
+ */
+class Session
+{
+private:
+    Board start;
+    Board board;
+    std::vector<MoveRecord> history;
+
+public:
+    /**
+     * @brief Starts a game
+     * @param startPosition Position the game starts from
+     */
+    explicit Session(const Board &startPosition) : start(startPosition), board(startPosition) {}
+
+    /**
+     * @brief Plays a legal move and records it with its SAN
+     * @param move Move to play; the caller checks that it is legal
+     */
+    void play(const Move &move);
+
+    /**
+     * @brief Gets the current position
+     * @return Reference to the board
+     */
+    Board &getBoard() { return board; }
+
+    /**
+     * @brief Gets the moves played so far
+     * @return Played moves in order
+     */
+    const std::vector<MoveRecord> &getHistory() const { return history; }
+
+    /**
+     * @brief Compresses the game for hibernation
+     * @return Starting position and move indices
+     */
+    PackedGame pack() const;
+
+    /**
+     * @brief Rebuilds a game by replaying a packed one
+     * @param packed Game produced by pack()
+     * @return The game, or nullptr if the packed moves do not fit the position
+     */
+    static std::unique_ptr<Session> unpack(const PackedGame &packed);
+};
+
+class SessionSlab;
+
+/**
+ * @class SessionManager
+ * @brief Holds the open games of a server, hibernating idle ones
+ * @details Sessions not used for the idle limit are replaced by their PackedGame,
+ *          tens of bytes instead of a board, history and SAN strings. A hibernated
+ *          session is rehydrated transparently the next time it is looked up.
+ *          With a SessionSlab attached, hibernated games beyond a memory limit are
+ *          spilled to disk, least recently used first, and read back on lookup.
+ */
+class SessionManager
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructs an empty manager
+     * @param idleSeconds Seconds a session may go unused before it is hibernated
+     */
+    explicit SessionManager(int idleSeconds = 60);
+
+    /**
+     * @brief Adds a disk tier below the hibernated games
+     * @param slab Slab to spill to; owned by the caller and kept open while attached
+     * @param memoryGames Most hibernated games to keep in memory
+     * @details Games already in the slab stay there and can be looked up, and new
+     *          ids continue after the largest id the slab holds.
+     */
+    void attachSlab(SessionSlab *slab, size_t memoryGames);
+
+    /**
+     * @brief Opens a new game
+     * @param startPosition Position the game starts from
+     * @return Id of the new session
+     */
+    uint32_t create(const Board &startPosition);
+
+    /**
+     * @brief Looks up a session, rehydrating it if it is hibernated, and marks it used
+     * @param id Session id
+     * @return The session, or nullptr if there is no such session
+     */
+    Session *find(uint32_t id);
+
+    /**
+     * @brief Closes a session
+     * @param id Session id
+     * @return true if the session existed
+     */
+    bool close(uint32_t id);
+
+    /**
+     * @brief Hibernates every session unused for longer than the idle limit
+     * @return Number of sessions hibernated
+     */
+    size_t hibernateIdle();
+
+    /**
+     * @brief Moves every session to the slab, e.g. before shutting down
+     * @return Number of sessions that could not be spilled and are still held in memory
+     */
+    size_t spillAll();
+
+    /**
+     * @brief Gets the number of sessions held in full
+     * @return Active session count
+     */
+    size_t getActiveCount() const { return active.size(); }
+
+    /**
+     * @brief Gets the number of hibernated sessions
+     * @return Hibernated session count
+     */
+    size_t getHibernatedCount() const { return hibernated.size(); }
+
+    /**
+     * @brief Gets the number of sessions spilled to the slab
+     * @return Spilled session count, 0 without a slab
+     */
+    size_t getSpilledCount() const;
+
+private:
+    struct ActiveSession
+    {
+        std::unique_ptr<Session> session;
+        Clock::time_point lastUsed;
+    };
+
+    struct HibernatedGame
+    {
+        PackedGame game;
+        std::list<uint32_t>::iterator recency;  ///< Position in coldOrder
+    };
+
+    std::unordered_map<uint32_t, ActiveSession> active;
+    std::unordered_map<uint32_t, HibernatedGame> hibernated;
+    std::list<uint32_t> coldOrder;  ///< Hibernated ids, least recently used first
+    SessionSlab *slab;
+    size_t memoryLimit;
+    uint32_t nextId;
+    Clock::duration idleLimit;
+
+    /**
+     * @brief Spills the least recently used hibernated games until the memory limit holds
+     */
+    void spillColdest();
+};
+
+#endif
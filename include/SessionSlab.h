@@ -0,0 +1,119 @@
+#ifndef SESSIONSLAB_H
+#define SESSIONSLAB_H
+
+#include "SessionManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class SessionSlab
+ * @brief Disk tier for packed games: a memory-mapped file of fixed-size slots
+ * @details The file holds a header, an open-addressing index from session id to
+ *          first slot, and 128-byte slots chained for longer games. Freed slots go
+ *          on a free list and are reused before the file grows. The index is rebuilt
+ *          without its erased entries once three quarters of it is used, and doubles,
+ *          moving the slots up, if more than half of it then holds live games.
+ *          Everything lives in the mapping, so reopening a slab only maps it; pages
+ *          are read on demand.
+ */
+class SessionSlab
+{
+public:
+    /**
+     * @brief Opens a slab file, creating it if it does not exist
+     * @param path File to open
+     * @param capacity Games a new file can index before its index first grows; ignored when the file exists
+     * @throws std::runtime_error If the file cannot be opened, mapped, or is not a slab
+     */
+    explicit SessionSlab(const std::string &path, uint32_t capacity = 1u << 20);
+
+    ~SessionSlab();
+
+    SessionSlab(const SessionSlab &) = delete;
+    SessionSlab &operator=(const SessionSlab &) = delete;
+
+    /**
+     * @brief Writes a game, replacing any stored under the same id
+     * @param id Session id, not 0
+     * @param game Game to store
+     * @return false if the file cannot grow; a game already stored under the id is then kept
+     */
+    bool store(uint32_t id, const PackedGame &game);
+
+    /**
+     * @brief Reads a game
+     * @param id Session id
+     * @param game Receives the game
+     * @return false if no game is stored under the id
+     */
+    bool load(uint32_t id, PackedGame &game) const;
+
+    /**
+     * @brief Removes a game and frees its slots
+     * @param id Session id
+     * @return false if no game was stored under the id
+     */
+    bool erase(uint32_t id);
+
+    /**
+     * @brief Gets the number of stored games
+     * @return Game count
+     */
+    size_t getCount() const;
+
+    /**
+     * @brief Gets the largest session id ever stored, so new ids do not collide
+     * @return Largest id, or 0
+     */
+    uint32_t getMaxId() const;
+
+private:
+    struct Header;
+    struct IndexEntry;
+    struct Slot;
+
+    int fd;
+    void *mapping;
+    size_t mappedBytes;
+
+    Header *header() const;
+    IndexEntry *index() const;
+    Slot *slot(uint32_t number) const;
+
+    /**
+     * @brief Finds the index entry of an id
+     * @param id Session id
+     * @param insert true to return the entry a new id would take
+     * @return Entry holding the id, the free entry for it when inserting, or nullptr
+     */
+    IndexEntry *findEntry(uint32_t id, bool insert) const;
+
+    /**
+     * @brief Rebuilds the index without erased entries
+     * @param indexSize New number of entries, a power of two not below the current one
+     * @return false if the file cannot grow; the index is then unchanged
+     */
+    bool rehash(uint32_t indexSize);
+
+    /**
+     * @brief Takes a slot from the free list, growing the file if it is empty
+     * @return Slot number, unlinked from the free list, or UINT32_MAX if the file cannot grow
+     */
+    uint32_t allocateSlot();
+
+    /**
+     * @brief Returns a chain of slots to the free list
+     * @param first First slot of the chain
+     */
+    void freeChain(uint32_t first);
+
+    /**
+     * @brief Resizes the file and its mapping
+     * @param bytes New size
+     * @return true on success
+     */
+    bool remap(size_t bytes);
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef SMPSEARCH_H
+#define SMPSEARCH_H
+
+#include "Search.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @enum NumaPolicy
+ * @brief How a parallel search lays out its threads and table on a NUMA machine
+ */
+enum class NumaPolicy
+{
+    OFF,         ///< No pinning; one table placed wherever the kernel puts it
+    INTERLEAVE,  ///< Threads pinned per node; one table spread over all nodes
+    REPLICATE    ///< Threads pinned per node; one table per node, shared by that node's threads
+};
+
+/**
+ * @class SmpSearch
+ * @brief Lazy SMP: several searches of the same position sharing a transposition table
+ * @details Every thread runs its own iterative deepening on its own board; they help
+ *          each other only through the table. The first thread's result is reported.
+ *          On a single-node machine all policies behave like NumaPolicy::OFF.
+ */
+class SmpSearch
+{
+public:
+    /**
+     * @brief Creates the threads' searches and tables
+     * @details Each Search is constructed on a thread already pinned to its node, so
+     *          its per-ply frames are first touched, and placed, on that node.
+     * @param threads Number of search threads, at least 1
+     * @param hashMb Size of each transposition table in MiB
+     * @param policy Thread and table placement
+     */
+    SmpSearch(unsigned threads, size_t hashMb, NumaPolicy policy);
+
+    /**
+     * @brief Searches the position for the side to move
+     * @details The tables are kept from one search to the next; each search starts a
+     *          new table generation so older entries are replaced first.
+     * @param board Board to search; every thread searches its own copy
+     * @param limits Depth, node and time budget; a node budget is split between threads
+     * @param onIteration Optional callback invoked after every iteration of the first thread
+     * @return Information about the first thread's deepest completed iteration
+     */
+    SearchInfo run(const Board &board, const SearchLimits &limits,
+                   const std::function<void(const SearchInfo &)> &onIteration = nullptr);
+
+    /**
+     * @brief Asks a running search to stop as soon as possible; safe to call from any thread
+     */
+    void stop() { stopped = true; }
+
+    /**
+     * @brief Empties the transposition tables
+     */
+    void clearTables();
+
+    /**
+     * @brief Gets the nodes visited by all threads in the last search
+     * @return Node count
+     */
+    uint64_t getNodes() const;
+
+    /**
+     * @brief Gets the nodes of the last search, over all threads, answered or ordered by
+     *        a table entry from an earlier search
+     * @return Node count
+     */
+    uint64_t getReusedNodes() const;
+
+    /**
+     * @brief Gets the number of search threads
+     * @return Thread count
+     */
+    unsigned getThreadCount() const { return (unsigned)searches.size(); }
+
+private:
+    NumaPolicy policy;
+    std::atomic<bool> stopped;
+    std::vector<int> threadNodes;                               ///< Position in Numa::nodes() per thread
+    std::vector<std::unique_ptr<TranspositionTable>> tables;    ///< One table, or one per node
+    std::vector<std::unique_ptr<Search>> searches;              ///< One search per thread
+
+    /**
+     * @brief Runs a function on one thread per search, pinned per the policy, and waits
+     * @param function Callable taking the thread index
+     */
+    void forEachThread(const std::function<void(unsigned)> &function);
+};
+
+#endif
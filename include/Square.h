@@ -0,0 +1,142 @@
+#ifndef SQUARE_H
+#define SQUARE_H
+
+#include <cstdint>
+
+/**
+ * @brief A square index, row * 8 + col, so 0 is a8 and 63 is h1
+ */
+using Square = uint8_t;
+
+/**
+ * @brief A set of squares, one bit per square
+ * @details Bit (row * 8 + col) is set for the square at that row and column, so
+ *          bit 0 is a8 and bit 63 is h1, matching Square's layout.
+ */
+using Bitboard = uint64_t;
+
+/**
+ * @brief Square value of an off-board position
+ */
+const Square NO_SQUARE = 64;
+
+/**
+ * @brief Gets the square at a row and column
+ * @param row Row index (0-7, where 0 is rank 8)
+ * @param col Column index (0-7, where 0 is file 'a')
+ * @return Square index, or NO_SQUARE if off the board
+ */
+constexpr Square makeSquare(int row, int col)
+{
+    return (row >= 0 && row < 8 && col >= 0 && col < 8) ? (Square)(row * 8 + col) : NO_SQUARE;
+}
+
+/**
+ * @brief Gets the row of a square
+ * @param square Square index
+ * @return Row index (0-7)
+ */
+constexpr int rowOf(Square square) { return square >> 3; }
+
+/**
+ * @brief Gets the column of a square
+ * @param square Square index
+ * @return Column index (0-7)
+ */
+constexpr int colOf(Square square) { return square & 7; }
+
+/**
+ * @struct SquareTables
+ * @brief Geometry between squares, computed at compile time
+ */
+struct SquareTables
+{
+    Bitboard rank[64];          ///< Squares on the same row
+    Bitboard file[64];          ///< Squares on the same column
+    Bitboard diagonal[64];      ///< Squares with the same row - col (parallel to a8-h1)
+    Bitboard antiDiagonal[64];  ///< Squares with the same row + col (parallel to a1-h8)
+    Bitboard between[64][64];   ///< Squares strictly between two aligned squares, else 0
+    Bitboard line[64][64];      ///< Whole line through two aligned squares, else 0
+    uint8_t distance[64][64];   ///< King-move distance between two squares
+
+    constexpr SquareTables()
+        : rank(), file(), diagonal(), antiDiagonal(), between(), line(), distance()
+    {
+        for (int a = 0; a < 64; a++)
+        {
+            for (int b = 0; b < 64; b++)
+            {
+                Bitboard bit = 1ULL << b;
+                int rowDiff = rowOf((Square)b) - rowOf((Square)a);
+                int colDiff = colOf((Square)b) - colOf((Square)a);
+                if (rowDiff == 0)
+                    rank[a] |= bit;
+                if (colDiff == 0)
+                    file[a] |= bit;
+                if (rowDiff == colDiff)
+                    diagonal[a] |= bit;
+                if (rowDiff == -colDiff)
+                    antiDiagonal[a] |= bit;
+
+                int rowDist = rowDiff < 0 ? -rowDiff : rowDiff;
+                int colDist = colDiff < 0 ? -colDiff : colDiff;
+                distance[a][b] = (uint8_t)(rowDist > colDist ? rowDist : colDist);
+            }
+        }
+
+        for (int a = 0; a < 64; a++)
+        {
+            for (int b = 0; b < 64; b++)
+            {
+                if (a == b)
+                    continue;
+
+                Bitboard bit = 1ULL << b;
+                const Bitboard masks[] = {rank[a], file[a], diagonal[a], antiDiagonal[a]};
+                for (Bitboard mask : masks)
+                {
+                    if (mask & bit)
+                        line[a][b] = mask;
+                }
+                if (!line[a][b])
+                    continue;
+
+                int rowStep = (rowOf((Square)b) > rowOf((Square)a)) - (rowOf((Square)b) < rowOf((Square)a));
+                int colStep = (colOf((Square)b) > colOf((Square)a)) - (colOf((Square)b) < colOf((Square)a));
+                for (int s = a + rowStep * 8 + colStep; s != b; s += rowStep * 8 + colStep)
+                    between[a][b] |= 1ULL << s;
+            }
+        }
+    }
+};
+
+/**
+ * @brief The geometry tables, shared by every translation unit
+ */
+inline constexpr SquareTables SQUARE_TABLES{};
+
+/**
+ * @brief Gets the squares strictly between two squares on a line
+ * @param a First square
+ * @param b Second square
+ * @return Bitboard of the squares in between, or 0 if not on a common line
+ */
+inline Bitboard betweenMask(Square a, Square b) { return SQUARE_TABLES.between[a][b]; }
+
+/**
+ * @brief Gets the line through two squares
+ * @param a First square
+ * @param b Second square
+ * @return Bitboard of the whole rank, file or diagonal, or 0 if not on a common line
+ */
+inline Bitboard lineMask(Square a, Square b) { return SQUARE_TABLES.line[a][b]; }
+
+/**
+ * @brief Gets the number of king moves between two squares
+ * @param a First square
+ * @param b Second square
+ * @return Chebyshev distance (0-7)
+ */
+inline int distance(Square a, Square b) { return SQUARE_TABLES.distance[a][b]; }
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "Bitboard.h"
+#include "Board.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct CanonicalForm
+ * @brief The representative of a position's symmetry class and how it was reached
+ */
+struct CanonicalForm
+{
+    BitboardPosition position;  ///< Position in canonical orientation
+    uint64_t key = 0;           ///< Zobrist key of the canonical position
+    bool mirrored = false;      ///< true if files were mirrored (a <-> h)
+    bool colorSwapped = false;  ///< true if ranks were flipped and colors exchanged
+};
+
+/**
+ * @class Symmetry
+ * @brief Utility class mapping positions onto one representative per symmetry class
+ * @details A position is equivalent to its left-right mirror when neither side can
+ *          castle, and, for analysis purposes, to the position with ranks flipped and
+ *          colors exchanged. The canonical form is the variant with the smallest key.
+ */
+class Symmetry
+{
+public:
+    /**
+     * @brief Converts a board to bitboard form
+     * @param board Reference to the game board
+     * @return Bitboards, side to move, castling rights and capturable en passant file
+     */
+    static BitboardPosition fromBoard(const Board &board);
+
+    /**
+     * @brief Describes a bitboard position in Forsyth-Edwards Notation
+     * @param position Bitboard form of the position
+     * @return FEN string with clocks reset to "0 1"
+     */
+    static std::string toFEN(const BitboardPosition &position);
+
+    /**
+     * @brief Mirrors a position left to right
+     * @param position Position without castling rights
+     * @return Mirrored position
+     */
+    static BitboardPosition mirror(const BitboardPosition &position);
+
+    /**
+     * @brief Flips a position top to bottom and exchanges the colors
+     * @param position Position to transform
+     * @return The same position seen from the other side
+     */
+    static BitboardPosition swapColors(const BitboardPosition &position);
+
+    /**
+     * @brief Finds the canonical form of a position
+     * @param board Reference to the game board
+     * @param allowColorSwap true to treat color-swapped positions as equivalent
+     * @return Canonical position, its key and the transforms applied
+     */
+    static CanonicalForm canonicalize(const Board &board, bool allowColorSwap = false);
+
+    /**
+     * @brief Gets the key shared by every position in a symmetry class
+     * @param board Reference to the game board
+     * @param allowColorSwap true to treat color-swapped positions as equivalent
+     * @return Zobrist key of the canonical form
+     */
+    static uint64_t canonicalKey(const Board &board, bool allowColorSwap = false)
+    {
+        return canonicalize(board, allowColorSwap).key;
+    }
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include "Move.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum Bound
+ * @brief How a stored score relates to the true score of the position
+ */
+enum class Bound : uint8_t
+{
+    NONE,
+    UPPER,  ///< The search failed low; the true score is at most this
+    LOWER,  ///< The search failed high; the true score is at least this
+    EXACT   ///< The score is exact
+};
+
+/**
+ * @struct TTData
+ * @brief One stored search result
+ */
+struct TTData
+{
+    Move move;                  ///< Best or refuting move, or a null move
+    int score = 0;              ///< Score from the side to move's point of view
+    int depth = 0;              ///< Remaining depth the score was searched to
+    Bound bound = Bound::NONE;  ///< How score bounds the true score
+    bool carried = false;       ///< Set by probe for entries stored before the last newSearch()
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Fixed-size hash table of search results, shared by any number of threads
+ * @details Each slot is two 64-bit words: the packed data and the key XORed with
+ *          it. A slot torn by two threads writing at once fails the key check and
+ *          reads as a miss, so no locks are needed. Entries are stamped with the
+ *          generation of the search that stored them, so a table kept across the
+ *          moves of a game prefers to overwrite what earlier searches left behind.
+ */
+class TranspositionTable
+{
+public:
+    /**
+     * @enum Placement
+     * @brief Where the table's pages live on a NUMA machine
+     */
+    enum class Placement
+    {
+        DEFAULT,     ///< Wherever the kernel first touches them
+        NODE,        ///< All on one node
+        INTERLEAVED  ///< Round-robin over all nodes
+    };
+
+    /**
+     * @brief Allocates and clears a table
+     * @param megabytes Size in MiB; rounded down to a power-of-two number of slots
+     * @param placement Page placement; ignored on a single-node machine
+     * @param node Position in Numa::nodes() for Placement::NODE
+     */
+    explicit TranspositionTable(size_t megabytes, Placement placement = Placement::DEFAULT, int node = 0);
+
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    /**
+     * @brief Looks up a position
+     * @param key Zobrist key of the position
+     * @param data Receives the stored result on a hit
+     * @return true if the position was found
+     */
+    bool probe(uint64_t key, TTData &data) const;
+
+    /**
+     * @brief Stores a search result
+     * @details Results from earlier generations are always replaced. Within the current
+     *          generation, a result for the same position is only replaced by one that is
+     *          at least as deep, or that is exact, and a result for another position only
+     *          when it is not much deeper than the new one.
+     * @param key Zobrist key of the position
+     * @param data Result to store; score must fit in 16 bits
+     */
+    void store(uint64_t key, const TTData &data);
+
+    /**
+     * @brief Starts a new generation; call between searches, not during one
+     * @details Everything stored so far stays readable but becomes carried over
+     *          and is replaced first.
+     */
+    void newSearch() { generation = (generation + 1) & GENERATION_MASK; }
+
+    /**
+     * @brief Empties every slot
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of slots
+     * @return Slot count, a power of two
+     */
+    size_t getSlotCount() const { return slotCount; }
+
+private:
+    static const uint8_t GENERATION_MASK = 63;
+    static const int REPLACE_MARGIN = 3;    ///< Depth by which a current entry must exceed a new one to survive it
+
+    struct Slot
+    {
+        std::atomic<uint64_t> check;  ///< key ^ data
+        std::atomic<uint64_t> data;
+    };
+
+    Slot *slots;
+    size_t slotCount;
+    size_t bytes;
+    uint8_t generation;
+
+    Slot &slotFor(uint64_t key) const { return slots[key & (slotCount - 1)]; }
+};
+
+#endif
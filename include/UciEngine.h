@@ -0,0 +1,102 @@
+#ifndef UCIENGINE_H
+#define UCIENGINE_H
+
+#include "Board.h"
+#include "SmpSearch.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @class UciEngine
+ * @brief Universal Chess Interface front-end, for tournament managers and GUIs
+ * @details The input thread only parses commands. `go` starts the search on a worker
+ *          thread and a timer thread that enforces the time budget, so `stop`,
+ *          `ponderhit` and `isready` are handled while the search runs; `stop` takes
+ *          effect at the search's next node.
+ */
+class UciEngine
+{
+public:
+    /**
+     * @brief Constructs an engine with one search thread and a 16 MiB table
+     * @param output Stream the engine writes its replies to
+     */
+    explicit UciEngine(std::ostream &output = std::cout);
+
+    /**
+     * @brief Stops any running search
+     */
+    ~UciEngine();
+
+    UciEngine(const UciEngine &) = delete;
+    UciEngine &operator=(const UciEngine &) = delete;
+
+    /**
+     * @brief Reads and executes commands until `quit` or the end of the input
+     * @param input Stream of UCI commands, one per line
+     */
+    void run(std::istream &input);
+
+    /**
+     * @brief Executes one command
+     * @param line Command line
+     * @return false if the command was `quit`
+     */
+    bool execute(const std::string &line);
+
+private:
+    std::ostream &out;
+    std::mutex outputMutex;          ///< Serializes lines written by the input and search threads
+
+    Board board;
+    std::unique_ptr<SmpSearch> search;
+    unsigned threads;
+    size_t hashMb;
+
+    std::thread worker;              ///< Runs the search and reports the best move
+    std::thread timer;               ///< Stops the search when its time budget runs out
+    std::mutex stateMutex;
+    std::condition_variable stateChanged;
+    std::atomic<bool> halt;          ///< Raised by `stop` or the timer; read by the search callback
+    bool finished;                   ///< The search has returned
+    bool waitForStop;                ///< `go infinite` or `go ponder`: hold the best move until told
+    bool pondering;                  ///< Searching the predicted reply until `ponderhit`
+    int64_t budgetMs;                ///< Time for this move, or 0 for none
+    std::chrono::steady_clock::time_point deadline;  ///< When to stop, if budgetMs and not pondering
+
+    void position(std::istream &args);
+    void go(std::istream &args);
+    void setOption(std::istream &args);
+
+    /**
+     * @brief Stops the running search, if any, and waits for its best move to be sent
+     */
+    void stopSearch();
+
+    /**
+     * @brief Body of the worker thread
+     * @param root Position to search
+     * @param limits Depth and node budget; time is enforced by the timer thread
+     */
+    void searchLoop(Board root, SearchLimits limits);
+
+    /**
+     * @brief Body of the timer thread
+     */
+    void timerLoop();
+
+    /**
+     * @brief Writes one line of output
+     * @param line Line without its newline
+     */
+    void send(const std::string &line);
+};
+
+#endif
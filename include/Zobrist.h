@@ -0,0 +1,112 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "Bitboard.h"
+#include "Board.h"
+#include <cstdint>
+
+/**
+ * @struct ZobristKeys
+ * @brief Random key components of pieces, side to move, castling and en passant, computed at compile time
+ */
+struct ZobristKeys
+{
+    uint64_t pieces[12][64];   ///< Indexed by [piece type + 6 for Black][square]
+    uint64_t side;
+    uint64_t castling[4];
+    uint64_t enPassant[8];
+
+    constexpr ZobristKeys() : pieces(), side(), castling(), enPassant()
+    {
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (auto &square : pieces)
+            for (uint64_t &key : square)
+                key = next(state);
+        side = next(state);
+        for (uint64_t &key : castling)
+            key = next(state);
+        for (uint64_t &key : enPassant)
+            key = next(state);
+    }
+
+    /**
+     * @brief Steps a fixed-seed xorshift64* generator, so keys are identical across runs and builds
+     * @param state Generator state, advanced in place
+     * @return Next random value
+     */
+    static constexpr uint64_t next(uint64_t &state)
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+};
+
+/**
+ * @brief The key components, shared by every translation unit
+ */
+inline constexpr ZobristKeys ZOBRIST_KEYS{};
+
+/**
+ * @class Zobrist
+ * @brief Utility class computing 64-bit Zobrist keys for positions
+ * @details Two positions with the same pieces, side to move, castling rights and
+ *          capturable en passant square get the same key.
+ */
+class Zobrist
+{
+public:
+    /**
+     * @brief Computes the key of a position from scratch
+     * @param board Reference to the game board
+     * @return 64-bit position key, equal to board.getKey()
+     */
+    static uint64_t hash(const Board &board);
+
+    /**
+     * @brief Computes the key of a position given as bitboards
+     * @param position Bitboard form of the position
+     * @return 64-bit position key, equal to hash(board) for the same position
+     */
+    static uint64_t hash(const BitboardPosition &position);
+
+    /**
+     * @brief Gets the key component of a piece standing on a square
+     * @param letter Uppercase piece letter ('P', 'N', 'B', 'R', 'Q', 'K')
+     * @param color Color of the piece
+     * @param row Row index (0-7)
+     * @param col Column index (0-7)
+     * @return Random 64-bit value for that piece and square
+     */
+    static uint64_t pieceKey(char letter, Color color, int row, int col);
+
+    /**
+     * @brief Gets the key component toggled when Black is to move
+     * @return Random 64-bit value for the side to move
+     */
+    static uint64_t sideKey();
+
+    /**
+     * @brief Gets the key component of a castling right
+     * @param index 0 = White kingside, 1 = White queenside, 2 = Black kingside, 3 = Black queenside
+     * @return Random 64-bit value for that right
+     */
+    static uint64_t castlingKey(int index);
+
+    /**
+     * @brief Gets the key component of an en passant file
+     * @param col Column index (0-7) of the en passant target
+     * @return Random 64-bit value for that file
+     */
+    static uint64_t enPassantKey(int col);
+
+    /**
+     * @brief Checks if the en passant target can actually be captured
+     * @param board Reference to the game board
+     * @return true if a pawn of the side to move stands next to the pawn that just advanced
+     */
+    static bool isEnPassantCapturable(const Board &board);
+};
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef CHESS_H
+#define CHESS_H
+
+/**
+ * @file chess.h
+ * @brief C interface of libchess.so
+ * @details Boards and searches are opaque handles created and freed by the library;
+ *          every other call writes into memory the caller provides, so nothing
+ *          allocated on one side of the boundary is ever freed on the other. A handle
+ *          may be used by one thread at a time; different handles are independent.
+ *          No call throws or aborts: failures are reported through return values.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define CHESS_API __attribute__((visibility("default")))
+#else
+#define CHESS_API
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Version of this interface; raised only when an existing declaration changes */
+#define CHESS_API_VERSION 1
+
+/** @brief Most legal moves any position can have */
+#define CHESS_MAX_MOVES 256
+
+/** @brief Buffer size that fits any SAN or UCI move and its terminator */
+#define CHESS_MOVE_TEXT_SIZE 8
+
+/** @brief Buffer size that fits any FEN produced by chess_board_get_fen and its terminator */
+#define CHESS_FEN_SIZE 96
+
+/** @brief Longest principal variation a search reports */
+#define CHESS_MAX_PV 64
+
+/**
+ * @brief A move packed in 16 bits
+ * @details Bits 0-5 hold the source square and bits 6-11 the destination, both
+ *          numbered a1 = 0, b1 = 1, ..., h8 = 63. Bits 12-14 hold the promotion
+ *          piece: 0 none, 1 knight, 2 bishop, 3 rook, 4 queen. Castling is the king
+ *          moving two squares. The value 0 is never a legal move.
+ */
+typedef uint16_t chess_move;
+
+/** @brief No move */
+#define CHESS_MOVE_NONE ((chess_move)0)
+
+/** @brief Result codes of the calls that can fail */
+typedef enum
+{
+    CHESS_OK = 0,
+    CHESS_ERROR_INVALID = -1,  /**< Malformed argument, such as a bad FEN or an unparsable move */
+    CHESS_ERROR_ILLEGAL = -2,  /**< Well-formed move that is not legal in the position */
+    CHESS_ERROR_BUFFER = -3,   /**< Caller buffer too small */
+    CHESS_ERROR_MEMORY = -4    /**< The library could not allocate what it needed */
+} chess_result;
+
+/** @brief State of the game in a position */
+typedef enum
+{
+    CHESS_ONGOING = 0,
+    CHESS_CHECK = 1,      /**< Side to move is in check and has a legal move */
+    CHESS_CHECKMATE = 2,
+    CHESS_STALEMATE = 3,
+    CHESS_DRAW = 4        /**< Fifty-move rule */
+} chess_status;
+
+/** @brief Side to move */
+typedef enum
+{
+    CHESS_WHITE = 0,
+    CHESS_BLACK = 1
+} chess_color;
+
+/** @brief Budget of one search; a zero field means no limit on it */
+typedef struct
+{
+    int depth;         /**< Maximum depth in plies; 0 searches up to 64 */
+    uint64_t nodes;    /**< Maximum nodes over all threads */
+    int64_t time_ms;   /**< Maximum wall-clock time in milliseconds */
+} chess_search_limits;
+
+/** @brief Outcome of one search */
+typedef struct
+{
+    chess_move best_move;          /**< CHESS_MOVE_NONE if the side to move has no legal move */
+    int score;                     /**< Centipawns from the side to move's point of view */
+    int mate;                      /**< Moves to mate, negative if being mated, 0 if none found */
+    int depth;                     /**< Deepest completed iteration */
+    uint64_t nodes;                /**< Nodes over all threads */
+    int64_t time_ms;               /**< Wall-clock time of the search */
+    size_t pv_length;              /**< Number of moves in pv */
+    chess_move pv[CHESS_MAX_PV];   /**< Principal variation, starting with best_move */
+} chess_search_info;
+
+/** @brief Opaque board: a position and its side to move, castling rights and clocks */
+typedef struct chess_board chess_board;
+
+/** @brief Opaque search: threads and transposition table, kept from one search to the next */
+typedef struct chess_search chess_search;
+
+/**
+ * @brief Gets the interface version the library was built with
+ * @return CHESS_API_VERSION of the library, to compare with the header's
+ */
+CHESS_API int chess_api_version(void);
+
+/**
+ * @brief Creates a board set to the starting position
+ * @return The board, or NULL if it could not be allocated
+ */
+CHESS_API chess_board *chess_board_create(void);
+
+/**
+ * @brief Creates a copy of a board
+ * @param board Board to copy
+ * @return The copy, or NULL if it could not be allocated
+ */
+CHESS_API chess_board *chess_board_clone(const chess_board *board);
+
+/**
+ * @brief Frees a board; NULL is ignored
+ * @param board Board created by chess_board_create or chess_board_clone
+ */
+CHESS_API void chess_board_free(chess_board *board);
+
+/**
+ * @brief Sets up a board from a FEN string
+ * @param board Board to set; unchanged on failure
+ * @param fen NUL-terminated FEN
+ * @return CHESS_OK or CHESS_ERROR_INVALID
+ */
+CHESS_API chess_result chess_board_set_fen(chess_board *board, const char *fen);
+
+/**
+ * @brief Writes the FEN of a board
+ * @param board Board to describe
+ * @param out Buffer receiving the NUL-terminated FEN
+ * @param size Size of out; CHESS_FEN_SIZE is always enough
+ * @return Length of the FEN without the terminator, or CHESS_ERROR_BUFFER if it does not fit
+ */
+CHESS_API int chess_board_get_fen(const chess_board *board, char *out, size_t size);
+
+/**
+ * @brief Gets the side to move
+ * @param board Board to query
+ * @return CHESS_WHITE or CHESS_BLACK
+ */
+CHESS_API chess_color chess_board_side_to_move(const chess_board *board);
+
+/**
+ * @brief Lists the legal moves of the side to move
+ * @param board Board to query
+ * @param out Buffer receiving the moves
+ * @param capacity Number of moves out can hold; CHESS_MAX_MOVES is always enough
+ * @return Number of legal moves, or CHESS_ERROR_BUFFER if they do not fit
+ */
+CHESS_API int chess_board_legal_moves(const chess_board *board, chess_move *out, size_t capacity);
+
+/**
+ * @brief Plays a move
+ * @param board Board to play on; unchanged on failure
+ * @param move Move to play
+ * @return CHESS_OK or CHESS_ERROR_ILLEGAL
+ */
+CHESS_API chess_result chess_board_apply(chess_board *board, chess_move move);
+
+/**
+ * @brief Gets the state of the game
+ * @param board Board to query
+ * @return Checkmate, stalemate, a fifty-move draw, check or ongoing
+ */
+CHESS_API chess_status chess_board_status(const chess_board *board);
+
+/**
+ * @brief Parses a legal move in UCI coordinate notation
+ * @param board Board the move is played on
+ * @param uci NUL-terminated text such as "e2e4" or "e7e8q"
+ * @param move Receives the move
+ * @return CHESS_OK, CHESS_ERROR_INVALID if the text is not a move or CHESS_ERROR_ILLEGAL
+ */
+CHESS_API chess_result chess_move_from_uci(const chess_board *board, const char *uci, chess_move *move);
+
+/**
+ * @brief Formats a move in UCI coordinate notation; needs no board
+ * @param move Move to format
+ * @param out Buffer receiving the NUL-terminated text, such as "e7e8q"
+ * @param size Size of out; CHESS_MOVE_TEXT_SIZE is always enough
+ * @return Length of the text, CHESS_ERROR_INVALID for CHESS_MOVE_NONE or CHESS_ERROR_BUFFER
+ */
+CHESS_API int chess_move_to_uci(chess_move move, char *out, size_t size);
+
+/**
+ * @brief Parses a legal move in Standard Algebraic Notation
+ * @param board Board the move is played on
+ * @param san NUL-terminated text such as "Nf3", "exd8=Q+" or "O-O"
+ * @param move Receives the move
+ * @return CHESS_OK or CHESS_ERROR_ILLEGAL if no legal move matches
+ */
+CHESS_API chess_result chess_move_from_san(const chess_board *board, const char *san, chess_move *move);
+
+/**
+ * @brief Formats a legal move in Standard Algebraic Notation
+ * @param board Board the move is played on
+ * @param move Move to format
+ * @param out Buffer receiving the NUL-terminated text, check marks included
+ * @param size Size of out; CHESS_MOVE_TEXT_SIZE is always enough
+ * @return Length of the text, CHESS_ERROR_ILLEGAL or CHESS_ERROR_BUFFER
+ */
+CHESS_API int chess_move_to_san(const chess_board *board, chess_move move, char *out, size_t size);
+
+/**
+ * @brief Creates a search
+ * @param threads Number of search threads, at least 1
+ * @param hash_mb Size of the transposition table in MiB, at least 1
+ * @return The search, or NULL if it could not be allocated
+ */
+CHESS_API chess_search *chess_search_create(unsigned threads, size_t hash_mb);
+
+/**
+ * @brief Frees a search; NULL is ignored
+ * @param search Search created by chess_search_create and not running
+ */
+CHESS_API void chess_search_free(chess_search *search);
+
+/**
+ * @brief Searches a position for the side to move, blocking until done
+ * @param search Search to run; its table is kept for the next position
+ * @param board Position to search
+ * @param limits Budget; NULL for a depth 64 search that only chess_search_stop ends
+ * @param info Receives the result
+ * @return CHESS_OK or CHESS_ERROR_MEMORY
+ */
+CHESS_API chess_result chess_search_run(chess_search *search, const chess_board *board,
+                                        const chess_search_limits *limits, chess_search_info *info);
+
+/**
+ * @brief Asks a search to return as soon as possible
+ * @details Ends the chess_search_run call in progress on the handle, at the latest
+ *          after its current iteration. A stop made while no search runs has no
+ *          effect on later searches.
+ * @param search Search to stop; the only call that may be made from another thread
+ */
+CHESS_API void chess_search_stop(chess_search *search);
+
+/**
+ * @brief Empties the transposition table, forgetting earlier searches
+ * @param search Search to clear; not running
+ */
+CHESS_API void chess_search_clear(chess_search *search);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,11 +1,93 @@
+#include "Engine.h"
 #include "Game.h"
+#include "UciEngine.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
-int main()
+int main(int argc, char *argv[])
 {
     try
     {
+        // Optional: --pgn <file> appends the finished game to a PGN file,
+        // --ansi keeps the board in place and redraws only changed squares,
+        // --uci speaks the UCI protocol on standard input and output instead of playing,
+        // --engine white|black lets the computer play that side, with --mcts for the tree
+        // search instead of alpha-beta, --engine-time ms per move and --threads n,
+        // --review searches every move when the game ends and marks mistakes in the PGN,
+        // --coach checks each move in the background for hanging pieces and missed mates
+        std::unique_ptr<PgnWriter> pgnWriter;
+        bool ansi = false;
+        bool uci = false;
+        std::string engineSide;
+        EngineType engineType = EngineType::ALPHA_BETA;
+        int64_t engineTimeMs = 1000;
+        unsigned engineThreads = 1;
+        bool review = false;
+        bool coaching = false;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg == "--pgn" && i + 1 < argc)
+            {
+                pgnWriter = std::make_unique<PgnWriter>(argv[++i]);
+            }
+            else if (arg == "--ansi")
+            {
+                ansi = true;
+            }
+            else if (arg == "--uci")
+            {
+                uci = true;
+            }
+            else if (arg == "--engine" && i + 1 < argc)
+            {
+                engineSide = argv[++i];
+                if (engineSide != "white" && engineSide != "black")
+                    throw std::runtime_error("--engine takes white or black");
+            }
+            else if (arg == "--mcts")
+            {
+                engineType = EngineType::MCTS;
+            }
+            else if (arg == "--engine-time" && i + 1 < argc)
+            {
+                engineTimeMs = std::max(1LL, std::atoll(argv[++i]));
+            }
+            else if (arg == "--threads" && i + 1 < argc)
+            {
+                engineThreads = (unsigned)std::max(1, std::atoi(argv[++i]));
+            }
+            else if (arg == "--review")
+            {
+                review = true;
+            }
+            else if (arg == "--coach")
+            {
+                coaching = true;
+            }
+        }
+
+        if (uci)
+        {
+            UciEngine engine;
+            engine.run(std::cin);
+            return 0;
+        }
+
+        std::unique_ptr<Engine> engine;
+        if (!engineSide.empty())
+            engine = std::make_unique<Engine>(engineType, engineTimeMs, engineThreads);
+
         Game game;
+        game.setPgnWriter(pgnWriter.get());
+        game.setAnsiDisplay(ansi);
+        game.setEngine(engine.get(), engineSide == "white" ? Color::WHITE : Color::BLACK);
+        game.setReview(review);
+        game.setCoaching(coaching);
         game.start();
     }
     catch (const std::exception &e)
@@ -15,4 +97,4 @@ int main()
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,50 @@
+#include "AllocGuard.h"
+
+#ifdef SEARCH_ALLOC_GUARD
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Number of guards alive on this thread; allocation is forbidden while non-zero
+    thread_local int activeGuards = 0;
+}
+
+AllocationGuard::AllocationGuard()
+{
+    activeGuards++;
+}
+
+AllocationGuard::~AllocationGuard()
+{
+    activeGuards--;
+}
+
+// Replaces the global allocator for the whole program; the array forms forward here
+void *operator new(std::size_t size)
+{
+    if (activeGuards)
+    {
+        std::fputs("AllocationGuard: heap allocation inside a guarded scope\n", stderr);
+        std::abort();
+    }
+
+    void *memory = std::malloc(size ? size : 1);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "Analyzer.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    // Formats a score from White's point of view: "+0.35", "-1.20", "#3" or "#-2"
+    std::string formatScore(int score, Color sideToMove)
+    {
+        if (sideToMove == Color::BLACK)
+            score = -score;
+        if (Search::isMateScore(score))
+        {
+            int moves = (Search::MATE_SCORE - std::abs(score) + 1) / 2;
+            return "#" + std::to_string(score > 0 ? moves : -moves);
+        }
+        char text[16];
+        std::snprintf(text, sizeof(text), "%+.2f", score / 100.0);
+        return text;
+    }
+}
+
+Analyzer::Analyzer(size_t hashMb) : hashMb(hashMb), stopping(false), key(0)
+{
+}
+
+Analyzer::~Analyzer()
+{
+    stop();
+}
+
+void Analyzer::analyze(const Board &board)
+{
+    uint64_t position = Zobrist::hash(board);
+    if (isRunning() && position == key)
+        return;
+    stop();
+
+    if (!search)
+    {
+        table.reset(new TranspositionTable(hashMb));
+        search.reset(new Search());
+        search->setTable(table.get());
+        search->setSharedStop(&stopping);
+    }
+
+    key = position;
+    stopping = false;
+    table->newSearch();
+    auto analyzeRoot = [this, board]()
+    {
+        Board root = board;
+        auto report = [this, &root](const SearchInfo &info)
+        {
+            // Write the PV in SAN, replaying it on a copy of the root
+            Board line = root;
+            std::string text = "  [analysis] depth " + std::to_string(info.depth) + "  " +
+                               formatScore(info.score, root.getSideToMove()) + " ";
+            for (const Move &move : info.pv)
+            {
+                text += " " + Notation::toSan(line, move);
+                line.makeMove(move);
+            }
+
+            // Table cutoffs cut the search's PV short; continue it with the table's best moves
+            TTData entry;
+            for (int ply = (int)info.pv.size(); ply < info.depth && table->probe(Zobrist::hash(line), entry); ply++)
+            {
+                MoveList legal;
+                MoveGen::generate(GenType::LEGAL, line, line.getSideToMove(), legal);
+                if (std::find(legal.begin(), legal.end(), entry.move) == legal.end())
+                    break;
+                text += " " + Notation::toSan(line, entry.move);
+                line.makeMove(entry.move);
+            }
+            std::cout << text + "\n" << std::flush;
+        };
+        search->run(root, SearchLimits(), report);
+    };
+    worker = std::thread(analyzeRoot);
+}
+
+void Analyzer::stop()
+{
+    if (!worker.joinable())
+        return;
+    stopping = true;
+    worker.join();
+}
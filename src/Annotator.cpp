@@ -0,0 +1,115 @@
+#include "Annotator.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    // Mates are all worth about the same when measuring what a move lost
+    const int LOSS_CAP = 1500;
+
+    struct PositionScore
+    {
+        int score = 0;  // For the side to move
+        Move best;
+    };
+
+    // Formats a score from White's point of view: "+0.35", "-1.20", "#3" or "#-2"
+    std::string formatScore(int score, Color side)
+    {
+        if (side == Color::BLACK)
+            score = -score;
+        if (Search::isMateScore(score))
+        {
+            int moves = (Search::MATE_SCORE - std::abs(score) + 1) / 2;
+            return "#" + std::to_string(score > 0 ? moves : -moves);
+        }
+        char text[16];
+        std::snprintf(text, sizeof(text), "%+.2f", score / 100.0);
+        return text;
+    }
+}
+
+Annotator::Annotator(unsigned threads, size_t hashMb) : threadCount(std::max(1u, threads)), table(hashMb)
+{
+}
+
+std::vector<MoveReview> Annotator::annotate(const Board &start, const std::vector<Move> &moves,
+                                            const SearchLimits &limits)
+{
+    std::vector<Board> positions = {start};
+    positions.reserve(moves.size() + 1);
+    for (const Move &move : moves)
+    {
+        Board next = positions.back();
+        next.makeMove(move);
+        positions.push_back(next);
+    }
+
+    table.newSearch();
+    std::vector<PositionScore> scores(positions.size());
+    size_t last = positions.size() - 1;
+    auto searchPosition = [&](size_t i)
+    {
+        // Hand out positions from the end so later positions are in the table first
+        size_t index = last - i;
+        Board board = positions[index];
+
+        Color us = board.getSideToMove();
+        MoveList legal;
+        MoveGen::generate(GenType::LEGAL, board, us, legal);
+        if (legal.empty())
+        {
+            scores[index].score = board.isInCheck(us) ? -Search::MATE_SCORE : 0;
+            return;
+        }
+
+        Search search;
+        search.setTable(&table);
+        SearchInfo info = search.run(board, limits);
+        scores[index].score = info.score;
+        scores[index].best = info.bestMove().isNull() ? legal[0] : info.bestMove();
+    };
+    parallelFor(positions.size(), threadCount, searchPosition);
+
+    std::vector<MoveReview> reviews(moves.size());
+    for (size_t i = 0; i < moves.size(); i++)
+    {
+        MoveReview &review = reviews[i];
+        review.side = positions[i].getSideToMove();
+        review.scoreBefore = scores[i].score;
+        review.scoreAfter = -scores[i + 1].score;
+        review.bestMove = scores[i].best;
+        review.bestSan = Notation::toSan(positions[i], review.bestMove);
+
+        int before = std::min(std::max(review.scoreBefore, -LOSS_CAP), LOSS_CAP);
+        int after = std::min(std::max(review.scoreAfter, -LOSS_CAP), LOSS_CAP);
+        int loss = before - after;
+        if (loss >= BLUNDER_LOSS)
+            review.judgement = MoveJudgement::BLUNDER;
+        else if (loss >= MISTAKE_LOSS)
+            review.judgement = MoveJudgement::MISTAKE;
+        else if (moves[i] == review.bestMove)
+            review.judgement = MoveJudgement::BEST;
+    }
+    return reviews;
+}
+
+std::string Annotator::format(const MoveReview &review)
+{
+    switch (review.judgement)
+    {
+    case MoveJudgement::BEST:
+        return "$1";
+    case MoveJudgement::MISTAKE:
+    case MoveJudgement::BLUNDER:
+        return std::string(review.judgement == MoveJudgement::BLUNDER ? "$4 {Blunder (" : "$2 {Mistake (") +
+               formatScore(review.scoreAfter, review.side) + "). Best was " + review.bestSan + " (" +
+               formatScore(review.scoreBefore, review.side) + ")}";
+    default:
+        return "";
+    }
+}
@@ -0,0 +1,121 @@
+#include "BoardRenderer.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+namespace
+{
+    const char BORDER[] = "  +---+---+---+---+---+---+---+---+\n";
+    const char FILES[] = "    a   b   c   d   e   f   g   h\n\n";
+
+    // Screen layout of an ANSI frame, drawn from the top-left corner
+    const int FIRST_RANK_LINE = 2;     // Line of rank 8; ranks are two lines apart
+    const int FIRST_GLYPH_COLUMN = 5;  // Column of file a; files are four columns apart
+    const int PROMPT_LINE = 20;        // First line below the frame
+}
+
+BoardRenderer::BoardRenderer(int fd, bool ansi) : fd(fd), ansi(ansi), hasFrame(false), shown(), used(0)
+{
+}
+
+void BoardRenderer::append(const char *data, size_t length)
+{
+    if (used + length > BUFFER_SIZE)
+        flush();
+    std::memcpy(buffer + used, data, length);
+    used += length;
+}
+
+void BoardRenderer::append(const char *text)
+{
+    append(text, std::strlen(text));
+}
+
+void BoardRenderer::appendCursor(int row, int col)
+{
+    char sequence[16];
+    int length = std::snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row, col);
+    append(sequence, (size_t)length);
+}
+
+void BoardRenderer::appendFrame(const Board &board)
+{
+    append(BORDER, sizeof(BORDER) - 1);
+    for (int i = 0; i < 8; i++)
+    {
+        char rank[4] = {(char)('8' - i), ' ', '|', 0};
+        append(rank, 3);
+        for (int j = 0; j < 8; j++)
+        {
+            const Piece *piece = board.getPiece(i, j);
+            append(" ", 1);
+            append(piece ? piece->getGlyph() : " ");
+            append(" |", 2);
+        }
+        append("\n", 1);
+        append(BORDER, sizeof(BORDER) - 1);
+    }
+    append(FILES, sizeof(FILES) - 1);
+}
+
+void BoardRenderer::render(const Board &board)
+{
+    if (!ansi)
+    {
+        append("\n", 1);
+        appendFrame(board);
+        flush();
+        return;
+    }
+
+    if (!hasFrame)
+    {
+        // Home the cursor and clear the screen so the frame sits at a known place
+        append("\x1b[H\x1b[2J");
+        appendFrame(board);
+        for (int square = 0; square < 64; square++)
+            shown[square] = board.getPiece(square / 8, square % 8);
+        hasFrame = true;
+    }
+    else
+    {
+        for (int square = 0; square < 64; square++)
+        {
+            const Piece *piece = board.getPiece(square / 8, square % 8);
+            if (piece == shown[square])
+                continue;
+            appendCursor(FIRST_RANK_LINE + 2 * (square / 8), FIRST_GLYPH_COLUMN + 4 * (square % 8));
+            append(piece ? piece->getGlyph() : " ");
+            shown[square] = piece;
+        }
+    }
+
+    // Leave the cursor below the board with the text area cleared
+    appendCursor(PROMPT_LINE, 1);
+    append("\x1b[J");
+    flush();
+}
+
+void BoardRenderer::flush()
+{
+    // Anything already printed through stdio must reach the terminal first
+    if (fd == STDOUT_FILENO)
+        std::fflush(stdout);
+
+    const char *data = buffer;
+    size_t left = used;
+    while (left)
+    {
+        ssize_t written = ::write(fd, data, left);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        data += written;
+        left -= (size_t)written;
+    }
+    used = 0;
+}
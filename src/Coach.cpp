@@ -0,0 +1,153 @@
+#include "Coach.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include <algorithm>
+#include <cctype>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+    // Material a reply must win, against the best move, for the moved-from side to have hung a piece
+    const int HANG_LOSS = 150;
+
+    std::string squareName(const Position &pos)
+    {
+        return std::string(1, (char)('a' + pos.getCol())) + (char)('8' - pos.getRow());
+    }
+}
+
+Coach::Coach(unsigned threads, const SearchLimits &limits)
+    : threadCount(std::max(1u, threads)), limits(limits), quitting(false)
+{
+}
+
+Coach::~Coach()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quitting = true;
+        for (auto &worker : workers)
+            worker->cancelled = true;
+    }
+    ready.notify_all();
+    for (auto &worker : workers)
+        worker->thread.join();
+}
+
+SearchLimits Coach::defaultLimits()
+{
+    SearchLimits limits;
+    limits.depth = 5;
+    limits.timeMs = 150;
+    return limits;
+}
+
+void Coach::check(size_t ply, const Board &before, const Move &move)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &worker : workers)
+            worker->cancelled = true;
+        jobs.clear();
+        jobs.push_back(Job{ply, before, move});
+
+        if (workers.empty())
+        {
+            for (unsigned i = 0; i < threadCount; i++)
+            {
+                workers.emplace_back(new Worker());
+                workers.back()->search.setSharedStop(&workers.back()->cancelled);
+                workers.back()->thread = std::thread(&Coach::work, this, std::ref(*workers.back()));
+            }
+        }
+    }
+    ready.notify_one();
+}
+
+void Coach::cancel()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &worker : workers)
+        worker->cancelled = true;
+    jobs.clear();
+}
+
+void Coach::work(Worker &worker)
+{
+    // Stay out of the way of the game and of any engine search
+    setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 19);
+
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this]()
+                       { return quitting || !jobs.empty(); });
+            if (quitting)
+                return;
+            job = jobs.front();
+            jobs.pop_front();
+            worker.cancelled = false;
+        }
+
+        std::string text = review(worker, job);
+        if (!text.empty() && !worker.cancelled && onNote)
+            onNote(CoachNote{job.ply, text});
+    }
+}
+
+std::string Coach::review(Worker &worker, const Job &job)
+{
+    Board before = job.before;
+    Color us = before.getSideToMove();
+    std::string san = Notation::toSan(before, job.move);
+
+    Board after = before;
+    after.makeMove(job.move);
+    MoveList replies;
+    MoveGen::generate(GenType::LEGAL, after, after.getSideToMove(), replies);
+    if (replies.empty())
+        return "";
+
+    SearchInfo best = worker.search.run(before, limits);
+    if (worker.cancelled)
+        return "";
+    SearchInfo reply = worker.search.run(after, limits);
+    if (worker.cancelled)
+        return "";
+
+    // Both scores from the point of view of the side that moved
+    int scoreBefore = best.score;
+    int scoreAfter = -reply.score;
+
+    bool hadMate = Search::isMateScore(scoreBefore) && scoreBefore > 0;
+    bool keepsMate = Search::isMateScore(scoreAfter) && scoreAfter > 0;
+    if (hadMate && !keepsMate && !best.bestMove().isNull())
+    {
+        int moves = (Search::MATE_SCORE - scoreBefore + 1) / 2;
+        return san + " misses mate in " + std::to_string(moves) + " with " + Notation::toSan(before, best.bestMove());
+    }
+
+    Move refutation = reply.bestMove();
+    if (refutation.isNull() || scoreBefore - scoreAfter < HANG_LOSS)
+        return "";
+
+    if (Search::isMateScore(scoreAfter) && scoreAfter < 0)
+    {
+        int moves = (Search::MATE_SCORE + scoreAfter + 1) / 2;
+        return san + " allows mate in " + std::to_string(moves) + " with " + Notation::toSan(after, refutation);
+    }
+
+    const Piece *victim = after.getPiece(refutation.getTo());
+    if (!victim || victim->getColor() != us || victim->getType() == PieceType::KING)
+        return "";
+
+    std::string name = victim->getName();
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c)
+                   { return (char)std::tolower(c); });
+    return san + " hangs the " + name + " on " + squareName(refutation.getTo()) + " to " +
+           Notation::toSan(after, refutation);
+}
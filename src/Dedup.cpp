@@ -0,0 +1,146 @@
+#include "Dedup.h"
+#include "Board.h"
+#include "Notation.h"
+#include "Parallel.h"
+#include "Zobrist.h"
+#include <atomic>
+#include <memory>
+
+namespace
+{
+    const uint64_t EMPTY_GAME_HASH = 0xCBF29CE484222325ULL;
+    const uint64_t ROLLING_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+    // FNV-1a over the bare move text, so "Qxf7+!" and "Qxf7#" hash alike
+    uint64_t tokenHash(const std::string &san)
+    {
+        uint64_t hash = EMPTY_GAME_HASH;
+        for (char c : Notation::stripSan(san))
+        {
+            hash ^= (unsigned char)c;
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    Fingerprint wholeGame(const std::vector<uint64_t> &hashes)
+    {
+        Fingerprint fp;
+        fp.hash = hashes.empty() ? EMPTY_GAME_HASH : hashes.back();
+        fp.length = (uint32_t)hashes.size();
+        return fp;
+    }
+}
+
+void FingerprintMap::insert(const Fingerprint &fp, uint32_t game)
+{
+    Shard &shard = shardFor(fp);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto result = shard.entries.emplace(fp, game);
+    if (!result.second && game < result.first->second)
+        result.first->second = game;
+}
+
+bool FingerprintMap::find(const Fingerprint &fp, uint32_t &game)
+{
+    Shard &shard = shardFor(fp);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(fp);
+    if (it == shard.entries.end())
+        return false;
+    game = it->second;
+    return true;
+}
+
+bool Deduplicator::fingerprint(const PgnGame &game, std::vector<uint64_t> &hashes) const
+{
+    hashes.clear();
+    hashes.reserve(game.moves.size());
+
+    Board board;
+    std::string fen = game.getTag("FEN");
+    if (fen.empty())
+        board.initialize();
+    else if (!board.loadFEN(fen))
+        return false;
+
+    if (mode == Mode::MOVES)
+    {
+        // Polynomial rolling hash: every prefix hash falls out along the way. Seeding it with
+        // the starting position keeps the same moves from different FENs apart.
+        uint64_t hash = board.getKey();
+        for (const std::string &san : game.moves)
+        {
+            hash = hash * ROLLING_MULTIPLIER + tokenHash(san);
+            hashes.push_back(hash);
+        }
+        return true;
+    }
+
+    for (const std::string &san : game.moves)
+    {
+        Move move = Notation::fromSan(board, san);
+        if (move.isNull())
+            return false;
+        board.makeMove(move);
+        hashes.push_back(Zobrist::hash(board));
+    }
+    return true;
+}
+
+std::vector<GameStatus> Deduplicator::run(const std::vector<PgnGame> &games, unsigned threads) const
+{
+    std::vector<GameStatus> status(games.size(), GameStatus::UNIQUE);
+    std::vector<std::vector<uint64_t>> hashes(games.size());
+    auto map = std::make_unique<FingerprintMap>();
+
+    // Pass 1: fingerprint every game and remember the first game per fingerprint
+    parallelFor(games.size(), threads, [&](size_t i)
+    {
+        if (!fingerprint(games[i], hashes[i]))
+        {
+            status[i] = GameStatus::INVALID;
+            return;
+        }
+        map->insert(wholeGame(hashes[i]), (uint32_t)i);
+    });
+
+    // Pass 2: later copies are duplicates; any proper prefix found in the map is a shorter game
+    std::unique_ptr<std::atomic<bool>[]> isPrefix(new std::atomic<bool>[games.size()]);
+    for (size_t i = 0; i < games.size(); i++)
+        isPrefix[i] = false;
+
+    parallelFor(games.size(), threads, [&](size_t i)
+    {
+        if (status[i] == GameStatus::INVALID)
+            return;
+
+        uint32_t first;
+        if (map->find(wholeGame(hashes[i]), first) && first != i)
+            status[i] = GameStatus::DUPLICATE;
+
+        if (!dropPrefixes)
+            return;
+        for (size_t ply = 1; ply < hashes[i].size(); ply++)
+        {
+            Fingerprint prefix;
+            prefix.hash = hashes[i][ply - 1];
+            prefix.length = (uint32_t)ply;
+            uint32_t shorter;
+            if (map->find(prefix, shorter))
+                isPrefix[shorter] = true;
+        }
+    });
+
+    // Every copy of a prefix game goes, not only the first
+    for (size_t i = 0; i < games.size(); i++)
+    {
+        if (status[i] != GameStatus::UNIQUE || hashes[i].empty())
+            continue;
+        uint32_t first;
+        if (map->find(wholeGame(hashes[i]), first) && isPrefix[first])
+            status[i] = GameStatus::PREFIX;
+    }
+
+    return status;
+}
@@ -0,0 +1,41 @@
+#include "Engine.h"
+#include "MoveGen.h"
+
+Engine::Engine(EngineType type, int64_t moveTimeMs, unsigned threads, size_t hashMb)
+    : type(type), reusedFraction(0.0)
+{
+    limits.timeMs = moveTimeMs;
+    if (type == EngineType::MCTS)
+        mcts.reset(new Mcts(threads));
+    else
+        alphaBeta.reset(new SmpSearch(threads, hashMb, NumaPolicy::OFF));
+}
+
+Move Engine::chooseMove(const Board &board)
+{
+    if (mcts)
+    {
+        lastInfo = mcts->run(board, limits);
+        size_t size = mcts->getNodeCount();
+        reusedFraction = size ? (double)mcts->getReusedNodes() / size : 0.0;
+    }
+    else
+    {
+        lastInfo = alphaBeta->run(board, limits);
+        uint64_t nodes = alphaBeta->getNodes();
+        lastInfo.nodes = nodes;
+        reusedFraction = nodes ? (double)alphaBeta->getReusedNodes() / nodes : 0.0;
+    }
+
+    // A search stopped before its first iteration has no move; any legal one will do
+    Move move = lastInfo.bestMove();
+    if (move.isNull())
+    {
+        Board position = board;
+        MoveList moves;
+        MoveGen::generate(GenType::LEGAL, position, position.getSideToMove(), moves);
+        if (!moves.empty())
+            move = moves[0];
+    }
+    return move;
+}
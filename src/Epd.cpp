@@ -0,0 +1,111 @@
+#include "Epd.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    // Splits an operand list, keeping quoted strings together and removing the quotes
+    std::vector<std::string> splitOperands(const std::string &text)
+    {
+        std::vector<std::string> operands;
+        std::string current;
+        bool quoted = false;
+
+        for (char c : text)
+        {
+            if (c == '"')
+            {
+                quoted = !quoted;
+            }
+            else if (!quoted && (c == ' ' || c == '\t'))
+            {
+                if (!current.empty())
+                    operands.push_back(current);
+                current.clear();
+            }
+            else
+            {
+                current += c;
+            }
+        }
+        if (!current.empty())
+            operands.push_back(current);
+        return operands;
+    }
+}
+
+bool Epd::parseLine(const std::string &line, EpdEntry &entry)
+{
+    std::istringstream in(line);
+    std::string placement, side, castling, enPassant;
+    if (!(in >> placement >> side >> castling >> enPassant))
+        return false;
+    if (placement[0] == '#')
+        return false;
+
+    entry = EpdEntry();
+    entry.fen = placement + " " + side + " " + castling + " " + enPassant;
+
+    std::string rest;
+    std::getline(in, rest);
+
+    // Operations are "opcode operand...;" and quoted operands may contain ';'
+    std::string operation;
+    bool quoted = false;
+    int halfmove = 0, fullmove = 1;
+    for (size_t i = 0; i <= rest.length(); i++)
+    {
+        char c = (i < rest.length()) ? rest[i] : ';';
+        if (c == '"')
+            quoted = !quoted;
+        if (c != ';' || quoted)
+        {
+            operation += c;
+            continue;
+        }
+
+        std::vector<std::string> words = splitOperands(operation);
+        operation.clear();
+        if (words.empty())
+            continue;
+
+        std::string opcode = words[0];
+        words.erase(words.begin());
+        if (opcode == "bm")
+            entry.bestMoves = words;
+        else if (opcode == "am")
+            entry.avoidMoves = words;
+        else if (opcode == "id" && !words.empty())
+            entry.id = words[0];
+        else if (opcode == "dm" && !words.empty())
+            entry.mateIn = std::atoi(words[0].c_str());
+        else if (opcode == "hmvc" && !words.empty())
+            halfmove = std::atoi(words[0].c_str());
+        else if (opcode == "fmvn" && !words.empty())
+            fullmove = std::atoi(words[0].c_str());
+    }
+
+    entry.fen += " " + std::to_string(halfmove) + " " + std::to_string(fullmove);
+    return true;
+}
+
+std::vector<EpdEntry> Epd::loadFile(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Cannot open EPD file: " + path);
+
+    std::vector<EpdEntry> entries;
+    std::string line;
+    EpdEntry entry;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (parseLine(line, entry))
+            entries.push_back(entry);
+    }
+    return entries;
+}
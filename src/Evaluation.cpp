@@ -0,0 +1,81 @@
+#include "Evaluation.h"
+#include <cstdlib>
+
+namespace
+{
+    // Piece-square bonuses from White's point of view, indexed by [row][col] with row 0 = rank 8
+    const int pawnTable[8][8] = {
+        {0, 0, 0, 0, 0, 0, 0, 0},
+        {50, 50, 50, 50, 50, 50, 50, 50},
+        {10, 10, 20, 30, 30, 20, 10, 10},
+        {5, 5, 10, 25, 25, 10, 5, 5},
+        {0, 0, 0, 20, 20, 0, 0, 0},
+        {5, -5, -10, 0, 0, -10, -5, 5},
+        {5, 10, 10, -20, -20, 10, 10, 5},
+        {0, 0, 0, 0, 0, 0, 0, 0}};
+
+    const int kingTable[8][8] = {
+        {-30, -40, -40, -50, -50, -40, -40, -30},
+        {-30, -40, -40, -50, -50, -40, -40, -30},
+        {-30, -40, -40, -50, -50, -40, -40, -30},
+        {-30, -40, -40, -50, -50, -40, -40, -30},
+        {-20, -30, -30, -40, -40, -30, -30, -20},
+        {-10, -20, -20, -20, -20, -20, -20, -10},
+        {20, 20, 0, 0, 0, 0, 20, 20},
+        {20, 30, 10, 0, 0, 10, 30, 20}};
+
+    // Knights, bishops and queens prefer the centre
+    int centralization(int row, int col)
+    {
+        int rowDist = std::abs(2 * row - 7);
+        int colDist = std::abs(2 * col - 7);
+        return 20 - 2 * (rowDist + colDist);
+    }
+}
+
+int Evaluation::pieceValue(const Piece *piece)
+{
+    return piece ? materialValue(piece->getType()) : 0;
+}
+
+int Evaluation::evaluate(const Board &board)
+{
+    int score = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        for (int j = 0; j < 8; j++)
+        {
+            const Piece *piece = board.getPiece(i, j);
+            if (!piece)
+                continue;
+
+            // Mirror the row so both colors read the tables from their own side
+            int row = (piece->getColor() == Color::WHITE) ? i : 7 - i;
+            int value = pieceValue(piece);
+
+            switch (piece->getType())
+            {
+            case PieceType::PAWN:
+                value += pawnTable[row][j];
+                break;
+            case PieceType::KNIGHT:
+                value += 2 * centralization(row, j);
+                break;
+            case PieceType::BISHOP:
+            case PieceType::QUEEN:
+                value += centralization(row, j);
+                break;
+            case PieceType::KING:
+                value += kingTable[row][j];
+                break;
+            default:
+                break;
+            }
+
+            score += (piece->getColor() == Color::WHITE) ? value : -value;
+        }
+    }
+
+    return (board.getSideToMove() == Color::WHITE) ? score : -score;
+}
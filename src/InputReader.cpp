@@ -0,0 +1,124 @@
+#include "InputReader.h"
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+
+InputReader::InputReader(int fd, size_t bufferSize)
+    : fd(fd), buffer(new char[bufferSize < 256 ? 256 : bufferSize]), capacity(bufferSize < 256 ? 256 : bufferSize),
+      begin(0), end(0), eof(false)
+{
+}
+
+bool InputReader::fill(bool wait)
+{
+    if (eof)
+        return false;
+
+    if (!wait)
+    {
+        pollfd request = {fd, POLLIN, 0};
+        if (poll(&request, 1, 0) <= 0)
+            return false;
+    }
+
+    // Move the unread bytes to the front to make room
+    if (begin == end)
+    {
+        begin = end = 0;
+    }
+    else if (end == capacity)
+    {
+        std::memmove(buffer.get(), buffer.get() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    if (end == capacity)
+        return false;
+
+    while (true)
+    {
+        ssize_t count = ::read(fd, buffer.get() + end, capacity - end);
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+        {
+            eof = true;
+            return false;
+        }
+        end += (size_t)count;
+        return true;
+    }
+}
+
+bool InputReader::skipSpace(bool wait)
+{
+    while (true)
+    {
+        while (begin < end && std::isspace((unsigned char)buffer[begin]))
+            begin++;
+        if (begin < end)
+            return true;
+        if (!fill(wait))
+            return false;
+    }
+}
+
+bool InputReader::readToken(std::string &token)
+{
+    token.clear();
+    if (!skipSpace(true))
+        return false;
+
+    // A token may continue past the end of the buffer
+    while (true)
+    {
+        while (begin < end && !std::isspace((unsigned char)buffer[begin]))
+            token += buffer[begin++];
+        if (begin < end || !fill(true))
+            return true;
+    }
+}
+
+bool InputReader::readLine(std::string &line)
+{
+    line.clear();
+    while (true)
+    {
+        while (begin < end && buffer[begin] != '\n')
+            line += buffer[begin++];
+        if (begin < end)
+        {
+            begin++;
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            return true;
+        }
+        if (!fill(true))
+            return !line.empty();
+    }
+}
+
+bool InputReader::hasPending()
+{
+    return skipSpace(false);
+}
+
+bool InputReader::waitForInput(int timeoutMs)
+{
+    if (begin < end || eof)
+        return true;
+
+    pollfd request = {fd, POLLIN, 0};
+    int ready;
+    do
+        ready = poll(&request, 1, timeoutMs);
+    while (ready < 0 && errno == EINTR);
+    return ready != 0;
+}
+
+void InputReader::discardLine()
+{
+    while (begin < end && buffer[begin] != '\n')
+        begin++;
+}
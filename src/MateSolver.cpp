@@ -0,0 +1,328 @@
+#include "MateSolver.h"
+#include "Zobrist.h"
+#include <algorithm>
+
+namespace
+{
+    // Proof and disproof numbers saturate here; a number this large means "never"
+    const uint32_t INF = 0x3FFFFFFF;
+
+    uint32_t saturatingAdd(uint32_t a, uint32_t b)
+    {
+        return (uint32_t)std::min<uint64_t>((uint64_t)a + b, INF);
+    }
+}
+
+MateSolver::MateSolver(size_t hashMb)
+    : used(0), frames(new Frame[MAX_PLY + 1]), maxPly(MAX_PLY - 1), nodes(0), aborted(false), collections(0)
+{
+    size_t entries = 1024;
+    while (entries * 2 * sizeof(Entry) <= hashMb * 1024 * 1024)
+        entries *= 2;
+    table.assign(entries, Entry());
+}
+
+MateResult MateSolver::solve(Board &board, const MateLimits &mateLimits)
+{
+    limits = mateLimits;
+    maxPly = limits.moves > 0 ? std::min(2 * limits.moves - 1, MAX_PLY - 1) : MAX_PLY - 1;
+    nodes = 0;
+    aborted = false;
+    collections = 0;
+    std::fill(table.begin(), table.end(), Entry());
+    used = 0;
+    startTime = std::chrono::steady_clock::now();
+
+    Entry root;
+    expand(board, 0, INF, INF, root);
+
+    MateResult result;
+    result.proven = root.pn == 0;
+    result.disproven = root.dn == 0;
+    if (result.proven)
+    {
+        // The line is followed without limits: it only re-proves what was already proven
+        limits.nodes = 0;
+        limits.timeMs = 0;
+        aborted = false;
+        extractLine(board, result.line);
+        result.mateIn = ((int)result.line.size() + 1) / 2;
+    }
+    result.nodes = nodes;
+    result.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - startTime)
+                        .count();
+    result.collections = collections;
+    return result;
+}
+
+void MateSolver::expand(Board &board, int ply, uint32_t thresholdPn, uint32_t thresholdDn, Entry &result)
+{
+    uint64_t position = Zobrist::hash(board);
+    path[ply] = position;
+    result.key = keyAt(position, ply);
+    result.pn = result.dn = 1;
+    result.distance = 0;
+    if (aborted)
+        return;
+
+    uint64_t startNodes = nodes++;
+    if (limits.nodes && nodes >= limits.nodes)
+        aborted = true;
+    else if (limits.timeMs && (nodes & 1023) == 0 &&
+             std::chrono::steady_clock::now() - startTime >= std::chrono::milliseconds(limits.timeMs))
+        aborted = true;
+
+    // A checked defender's legal moves are exactly its evasions
+    bool attacker = (ply % 2) == 0;
+    Color us = board.getSideToMove();
+    Frame &frame = frames[ply];
+    frame.moves.clear();
+    MoveGen::generate(attacker ? attackerMoves() : GenType::LEGAL, board, us, frame.moves);
+
+    if (frame.moves.empty() || ply >= maxPly)
+    {
+        bool mated = frame.moves.empty() && !attacker && board.isInCheck(us);
+        result.pn = mated ? 0 : INF;
+        result.dn = mated ? INF : 0;
+        result.work = 1;
+        store(result);
+        return;
+    }
+
+    for (int i = 0; i < frame.moves.size(); i++)
+    {
+        MoveUndo undo = board.makeMove(frame.moves[i]);
+        uint64_t child = Zobrist::hash(board);
+        frame.keys[i] = keyAt(child, ply + 1);
+        board.unmakeMove(frame.moves[i], undo);
+
+        // A repetition is a draw, which refutes the mate; it depends on the path, so it is not stored
+        Entry entry;
+        if (std::find(path, path + ply + 1, child) != path + ply + 1)
+        {
+            frame.keys[i] = 0;
+            entry.pn = INF;
+            entry.dn = 0;
+            entry.distance = 0;
+        }
+        else if (!lookup(frame.keys[i], entry))
+        {
+            entry.pn = entry.dn = 1;
+            entry.distance = 0;
+        }
+        frame.pn[i] = entry.pn;
+        frame.dn[i] = entry.dn;
+        frame.distance[i] = entry.distance;
+    }
+
+    while (true)
+    {
+        // OR node for the attacker (one proven child suffices), AND node for the defender
+        int best = 0;
+        uint32_t second = INF;
+        if (attacker)
+        {
+            result.pn = INF;
+            result.dn = 0;
+            for (int i = 0; i < frame.moves.size(); i++)
+            {
+                result.dn = saturatingAdd(result.dn, frame.dn[i]);
+                if (frame.pn[i] < result.pn)
+                {
+                    second = result.pn;
+                    result.pn = frame.pn[i];
+                    best = i;
+                }
+                else if (frame.pn[i] < second)
+                {
+                    second = frame.pn[i];
+                }
+            }
+        }
+        else
+        {
+            result.pn = 0;
+            result.dn = INF;
+            for (int i = 0; i < frame.moves.size(); i++)
+            {
+                result.pn = saturatingAdd(result.pn, frame.pn[i]);
+                if (frame.dn[i] < result.dn)
+                {
+                    second = result.dn;
+                    result.dn = frame.dn[i];
+                    best = i;
+                }
+                else if (frame.dn[i] < second)
+                {
+                    second = frame.dn[i];
+                }
+            }
+        }
+
+        if (result.pn >= thresholdPn || result.dn >= thresholdDn || aborted)
+            break;
+
+        // Search the most proving child until it is no longer the most proving one
+        uint32_t childPn, childDn;
+        if (attacker)
+        {
+            childPn = std::min(thresholdPn, second + 1);
+            childDn = (uint32_t)std::min<uint64_t>((uint64_t)thresholdDn - result.dn + frame.dn[best], INF);
+        }
+        else
+        {
+            childDn = std::min(thresholdDn, second + 1);
+            childPn = (uint32_t)std::min<uint64_t>((uint64_t)thresholdPn - result.pn + frame.pn[best], INF);
+        }
+
+        Entry child;
+        const Move &move = frame.moves[best];
+        MoveUndo undo = board.makeMove(move);
+        expand(board, ply + 1, childPn, childDn, child);
+        board.unmakeMove(move, undo);
+        frame.pn[best] = child.pn;
+        frame.dn[best] = child.dn;
+        frame.distance[best] = child.distance;
+    }
+
+    // Mate distance: the attacker takes the quickest mate, the defender delays it longest
+    if (result.pn == 0)
+    {
+        uint32_t distance = attacker ? INF : 0;
+        for (int i = 0; i < frame.moves.size(); i++)
+        {
+            if (frame.pn[i] != 0)
+                continue;
+            distance = attacker ? std::min(distance, frame.distance[i]) : std::max(distance, frame.distance[i]);
+        }
+        result.distance = distance + 1;
+    }
+    result.work = (uint32_t)std::min<uint64_t>(nodes - startNodes, UINT32_MAX);
+    store(result);
+}
+
+uint64_t MateSolver::keyAt(uint64_t position, int ply) const
+{
+    uint64_t key = position;
+    if (limits.moves > 0)
+        key ^= (uint64_t)(maxPly - ply + 1) * 0x9E3779B97F4A7C15ULL;
+    return key ? key : 1;
+}
+
+bool MateSolver::lookup(uint64_t key, Entry &entry) const
+{
+    size_t mask = table.size() - 1;
+    for (size_t i = key & mask; table[i].key; i = (i + 1) & mask)
+    {
+        if (table[i].key == key)
+        {
+            entry = table[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+void MateSolver::store(const Entry &entry)
+{
+    size_t mask = table.size() - 1;
+    size_t i = entry.key & mask;
+    while (table[i].key && table[i].key != entry.key)
+        i = (i + 1) & mask;
+
+    if (!table[i].key)
+    {
+        // Keep the table at most three quarters full so probe sequences stay short
+        if (used + 1 > table.size() / 4 * 3)
+        {
+            collect();
+            i = entry.key & mask;
+            while (table[i].key)
+                i = (i + 1) & mask;
+        }
+        used++;
+    }
+    table[i] = entry;
+}
+
+void MateSolver::collect()
+{
+    collections++;
+
+    // SmallTreeGC: the median work of unproven entries splits cheap results from costly ones
+    std::vector<uint32_t> work;
+    work.reserve(used);
+    for (const Entry &entry : table)
+    {
+        if (entry.key && entry.pn != 0)
+            work.push_back(entry.work);
+    }
+    uint32_t threshold = 0;
+    if (!work.empty())
+    {
+        std::nth_element(work.begin(), work.begin() + work.size() / 2, work.end());
+        threshold = work[work.size() / 2];
+    }
+
+    // Proofs are kept unless they alone would fill the table
+    std::vector<Entry> kept;
+    kept.reserve(table.size() / 2);
+    for (const Entry &entry : table)
+    {
+        if (entry.key && entry.work > threshold && kept.size() < table.size() / 2)
+            kept.push_back(entry);
+    }
+    for (const Entry &entry : table)
+    {
+        if (entry.key && entry.pn == 0 && entry.work <= threshold && kept.size() < table.size() / 2)
+            kept.push_back(entry);
+    }
+
+    std::fill(table.begin(), table.end(), Entry());
+    used = 0;
+    size_t mask = table.size() - 1;
+    for (const Entry &entry : kept)
+    {
+        size_t i = entry.key & mask;
+        while (table[i].key)
+            i = (i + 1) & mask;
+        table[i] = entry;
+        used++;
+    }
+}
+
+void MateSolver::extractLine(Board &board, std::vector<Move> &line)
+{
+    line.clear();
+    Board position = board;
+    for (int ply = 0; ply <= maxPly; ply++)
+    {
+        path[ply] = Zobrist::hash(position);
+        bool attacker = (ply % 2) == 0;
+        MoveList moves;
+        MoveGen::generate(attacker ? attackerMoves() : GenType::LEGAL, position, position.getSideToMove(), moves);
+
+        Move best;
+        uint32_t bestDistance = attacker ? INF : 0;
+        for (const Move &move : moves)
+        {
+            Board next = position;
+            next.makeMove(move);
+            Entry entry;
+            if (!lookup(keyAt(Zobrist::hash(next), ply + 1), entry))
+                expand(next, ply + 1, INF, INF, entry);
+            if (entry.pn != 0)
+                continue;
+            if (attacker ? entry.distance < bestDistance : entry.distance >= bestDistance)
+            {
+                best = move;
+                bestDistance = entry.distance;
+            }
+        }
+        if (best.isNull())
+            break;
+        line.push_back(best);
+        position.makeMove(best);
+    }
+}
@@ -0,0 +1,301 @@
+#include "Mcts.h"
+#include "Evaluation.h"
+#include "MoveGen.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const double EXPLORATION = 1.0;     // UCT exploration constant for results in [0, 1]
+    const double SCORE_SCALE = 200.0;   // Centipawns per unit of log-odds when valuing a leaf
+    const int QUIESCENCE_PLIES = 4;
+
+    // Resolves pending captures so a leaf is not valued in the middle of an exchange
+    int quiescence(const Board &board, int alpha, int beta, int plies)
+    {
+        int standPat = Evaluation::evaluate(board);
+        if (standPat >= beta || plies == 0)
+            return standPat;
+        alpha = std::max(alpha, standPat);
+
+        Color us = board.getSideToMove();
+        Board position = board;
+        MoveList captures;
+        MoveGen::generate(GenType::CAPTURES, position, us, captures);
+        for (const Move &move : captures)
+        {
+            Board next = board;
+            next.makeMove(move);
+            if (next.isInCheck(us))
+                continue;
+            int score = -quiescence(next, -beta, -alpha, plies - 1);
+            if (score >= beta)
+                return score;
+            alpha = std::max(alpha, score);
+        }
+        return alpha;
+    }
+
+    // Win probability of the side to move
+    double leafValue(const Board &board)
+    {
+        int score = quiescence(board, -Search::INFINITE_SCORE, Search::INFINITE_SCORE, QUIESCENCE_PLIES);
+        return 1.0 / (1.0 + std::exp(-score / SCORE_SCALE));
+    }
+}
+
+Mcts::Mcts(unsigned threads, size_t nodeCapacity)
+    : threadCount(std::max(1u, threads)), nodes(new Node[std::max<size_t>(2, nodeCapacity)]),
+      capacity(std::max<size_t>(2, nodeCapacity)), used(0), stopped(false), playouts(0),
+      hasTree(false), reused(0)
+{
+}
+
+SearchInfo Mcts::run(const Board &board, const SearchLimits &searchLimits)
+{
+    limits = searchLimits;
+    stopped = false;
+    playouts = 0;
+    startTime = std::chrono::steady_clock::now();
+    reused = hasTree ? reroot(board) : 0;
+    if (!reused)
+    {
+        used = 1;
+        reset(nodes[0], Move());
+    }
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threadCount; i++)
+        pool.emplace_back(&Mcts::work, this, std::cref(board));
+    work(board);
+    for (std::thread &thread : pool)
+        thread.join();
+
+    // Report the most visited line, the usual robust choice
+    SearchInfo info;
+    info.nodes = playouts;
+    info.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - startTime)
+                      .count();
+
+    const Node *node = &nodes[0];
+    while (node->state == EXPANDED && node->childCount && info.pv.size() < (size_t)Search::MAX_PLY)
+    {
+        const Node *best = nullptr;
+        for (uint32_t i = 0; i < node->childCount; i++)
+        {
+            const Node &child = nodes[node->firstChild + i];
+            if (!best || child.visits > best->visits)
+                best = &child;
+        }
+        if (!best->visits)
+            break;
+        if (info.pv.empty())
+            info.score = toCentipawns((double)best->value / VALUE_ONE / best->visits);
+        info.pv.push_back(best->move);
+        node = best;
+    }
+    info.depth = (int)info.pv.size();
+
+    rootBoard = board;
+    hasTree = true;
+    return info;
+}
+
+int Mcts::toCentipawns(double winRate)
+{
+    winRate = std::min(std::max(winRate, 1e-6), 1.0 - 1e-6);
+    return (int)std::lround(SCORE_SCALE * std::log(winRate / (1.0 - winRate)));
+}
+
+void Mcts::work(const Board &root)
+{
+    for (uint64_t count = 0; !stopped; count++)
+    {
+        Board board = root;
+        if (!playout(board))
+            stopped = true;
+
+        uint64_t total = ++playouts;
+        if (limits.nodes && total >= limits.nodes)
+            stopped = true;
+        else if (limits.timeMs && (count & 63) == 0 &&
+                 std::chrono::steady_clock::now() - startTime >= std::chrono::milliseconds(limits.timeMs))
+            stopped = true;
+    }
+}
+
+bool Mcts::playout(Board &board)
+{
+    Node *path[MAX_DEPTH];
+    int depth = 0;
+    Node *node = &nodes[0];
+    path[0] = node;
+    node->visits++;
+
+    // Selection; each visit is counted on the way down, a virtual loss until the result is backed up
+    while (node->state.load(std::memory_order_acquire) == EXPANDED && node->childCount && depth < MAX_DEPTH - 1)
+    {
+        node = &select(*node);
+        node->visits++;
+        board.makeMove(node->move);
+        path[++depth] = node;
+    }
+
+    // Expansion by whichever thread gets there first; the others just value the leaf
+    bool full = false;
+    uint8_t state = node->state.load(std::memory_order_acquire);
+    if (state == UNEXPANDED && node->state.compare_exchange_strong(state, EXPANDING, std::memory_order_acq_rel))
+    {
+        full = !expand(*node, board);
+        state = full ? UNEXPANDED : EXPANDED;
+        node->state.store(state, std::memory_order_release);
+    }
+
+    // terminal is only read once the node is published as expanded
+    bool terminal = state == EXPANDED && node->terminal;
+    double value = terminal ? (node->terminal - 1) / 2.0 : leafValue(board);
+
+    // Back up: each node holds the result for the side that moved into it
+    for (int i = depth; i >= 1; i--)
+    {
+        value = 1.0 - value;
+        path[i]->value += (uint64_t)std::lround(value * VALUE_ONE);
+    }
+    return !full;
+}
+
+bool Mcts::expand(Node &node, Board &board)
+{
+    Color us = board.getSideToMove();
+    MoveList moves;
+    MoveGen::generate(GenType::LEGAL, board, us, moves);
+    if (moves.empty())
+    {
+        node.terminal = board.isInCheck(us) ? 1 : 2;
+        return true;
+    }
+    if (board.getHalfmoveClock() >= 100)
+    {
+        node.terminal = 2;
+        return true;
+    }
+
+    size_t first = used.fetch_add(moves.size());
+    if (first + moves.size() > capacity)
+        return false;
+    for (int i = 0; i < moves.size(); i++)
+        reset(nodes[first + i], moves[i]);
+    node.firstChild = (uint32_t)first;
+    node.childCount = (uint16_t)moves.size();
+    return true;
+}
+
+Mcts::Node &Mcts::select(Node &node)
+{
+    double logVisits = std::log((double)std::max(1u, node.visits.load(std::memory_order_relaxed)));
+    Node *best = nullptr;
+    double bestScore = -1.0;
+    for (uint32_t i = 0; i < node.childCount; i++)
+    {
+        Node &child = nodes[node.firstChild + i];
+        uint32_t visits = child.visits.load(std::memory_order_relaxed);
+        if (!visits)
+            return child;
+
+        double mean = (double)child.value.load(std::memory_order_relaxed) / VALUE_ONE / visits;
+        double score = mean + EXPLORATION * std::sqrt(logVisits / visits);
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = &child;
+        }
+    }
+    return *best;
+}
+
+void Mcts::reset(Node &node, const Move &move)
+{
+    node.move = move;
+    node.state.store(UNEXPANDED, std::memory_order_relaxed);
+    node.terminal = 0;
+    node.childCount = 0;
+    node.firstChild = 0;
+    node.visits.store(0, std::memory_order_relaxed);
+    node.value.store(0, std::memory_order_relaxed);
+}
+
+size_t Mcts::reroot(const Board &board)
+{
+    // Look for the position among the root and its children and grandchildren
+    uint64_t key = Zobrist::hash(board);
+    uint32_t found = UINT32_MAX;
+    if (Zobrist::hash(rootBoard) == key)
+        found = 0;
+    const Node &root = nodes[0];
+    for (uint32_t i = 0; found == UINT32_MAX && root.state == EXPANDED && i < root.childCount; i++)
+    {
+        const Node &child = nodes[root.firstChild + i];
+        Board position = rootBoard;
+        position.makeMove(child.move);
+        if (Zobrist::hash(position) == key)
+        {
+            found = root.firstChild + i;
+            break;
+        }
+        for (uint32_t j = 0; child.state == EXPANDED && j < child.childCount; j++)
+        {
+            Board next = position;
+            next.makeMove(nodes[child.firstChild + j].move);
+            if (Zobrist::hash(next) == key)
+            {
+                found = child.firstChild + j;
+                break;
+            }
+        }
+    }
+    if (found == UINT32_MAX)
+        return 0;
+
+    // Copy the subtree breadth first into a scratch arena, then back to the front
+    std::vector<uint32_t> order = {found};
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const Node &node = nodes[order[i]];
+        for (uint32_t j = 0; node.state == EXPANDED && j < node.childCount; j++)
+            order.push_back(node.firstChild + j);
+    }
+
+    std::unique_ptr<Node[]> kept(new Node[order.size()]);
+    size_t next = 1;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const Node &node = nodes[order[i]];
+        copy(kept[i], node);
+        if (node.state == EXPANDED && node.childCount)
+        {
+            kept[i].firstChild = (uint32_t)next;
+            next += node.childCount;
+        }
+    }
+    for (size_t i = 0; i < order.size(); i++)
+        copy(nodes[i], kept[i]);
+
+    nodes[0].move = Move();
+    used = order.size();
+    return order.size();
+}
+
+void Mcts::copy(Node &to, const Node &from)
+{
+    to.move = from.move;
+    to.state.store(from.state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.terminal = from.terminal;
+    to.childCount = from.childCount;
+    to.firstChild = from.firstChild;
+    to.visits.store(from.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.value.store(from.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
@@ -0,0 +1,368 @@
+#include "MoveGen.h"
+#include "Attacks.h"
+#include "Bitboard.h"
+#include "SpecialMoves.h"
+#include <cstdlib>
+
+namespace
+{
+    const char promotionChoices[] = {'Q', 'R', 'B', 'N'};
+
+    const Bitboard FILE_A = 0x0101010101010101ULL;
+    const Bitboard FILE_H = 0x8080808080808080ULL;
+
+    /**
+     * @brief Board geometry seen from one side
+     * @details White moves towards row 0, so White's pawns step to lower square indices.
+     */
+    template <Color Us>
+    struct Side
+    {
+        static constexpr Color THEM = (Us == Color::WHITE) ? Color::BLACK : Color::WHITE;
+        static constexpr int UP = (Us == Color::WHITE) ? -8 : 8;
+        static constexpr Bitboard PROMOTION_ROW = (Us == Color::WHITE) ? 0xFFULL : 0xFFULL << 56;
+        static constexpr Bitboard THIRD_ROW = (Us == Color::WHITE) ? 0xFFULL << 40 : 0xFFULL << 16;
+    };
+
+    // Moves every square of a set by a square offset
+    template <int Offset>
+    Bitboard shift(Bitboard bb)
+    {
+        if constexpr (Offset > 0)
+            return bb << Offset;
+        else
+            return bb >> -Offset;
+    }
+
+    Position square(int index)
+    {
+        return Position::fromSquare((Square)index);
+    }
+
+    // Adds pawn moves to each target square from the square Offset behind it
+    template <int Offset>
+    void addPawnMoves(Bitboard targets, MoveList &moves)
+    {
+        while (targets)
+        {
+            int to = popLowest(targets);
+            moves.push(Move(square(to - Offset), square(to)));
+        }
+    }
+
+    template <int Offset>
+    void addPromotions(Bitboard targets, MoveList &moves)
+    {
+        while (targets)
+        {
+            int to = popLowest(targets);
+            for (char choice : promotionChoices)
+                moves.push(Move(square(to - Offset), square(to), choice));
+        }
+    }
+
+    template <Color Us, GenType Type>
+    void generatePawnMoves(const Board &board, Bitboard target, MoveList &moves)
+    {
+        constexpr Color Them = Side<Us>::THEM;
+        constexpr int Up = Side<Us>::UP;
+        constexpr Bitboard Promotion = Side<Us>::PROMOTION_ROW;
+
+        Bitboard pawns = board.getPieces(Us, PieceType::PAWN);
+        Bitboard empty = ~board.getOccupied();
+        Bitboard enemies = board.getPieces(Them);
+
+        Bitboard single = shift<Up>(pawns) & empty;
+        Bitboard left = shift<Up - 1>(pawns & ~FILE_A) & enemies;
+        Bitboard right = shift<Up + 1>(pawns & ~FILE_H) & enemies;
+        if constexpr (Type == GenType::EVASIONS)
+        {
+            left &= target;
+            right &= target;
+        }
+
+        if constexpr (Type == GenType::QUIETS || Type == GenType::EVASIONS)
+        {
+            Bitboard twice = shift<Up>(single & Side<Us>::THIRD_ROW) & empty;
+            Bitboard pushes = single & ~Promotion;
+            if constexpr (Type == GenType::EVASIONS)
+            {
+                pushes &= target;
+                twice &= target;
+            }
+            addPawnMoves<Up>(pushes, moves);
+            addPawnMoves<2 * Up>(twice, moves);
+        }
+
+        if constexpr (Type == GenType::CAPTURES || Type == GenType::EVASIONS)
+        {
+            addPawnMoves<Up - 1>(left & ~Promotion, moves);
+            addPawnMoves<Up + 1>(right & ~Promotion, moves);
+
+            Bitboard pushes = single & Promotion;
+            if constexpr (Type == GenType::EVASIONS)
+                pushes &= target;
+            addPromotions<Up>(pushes, moves);
+            addPromotions<Up - 1>(left & Promotion, moves);
+            addPromotions<Up + 1>(right & Promotion, moves);
+
+            if (board.isEnPassantAvailable())
+            {
+                Position ep = board.getEnPassantTarget();
+                Bitboard capturers = pawnAttacks(Them, ep.getSquare()) & pawns;
+                while (capturers)
+                    moves.push(Move(square(popLowest(capturers)), ep));
+            }
+        }
+    }
+
+    template <Color Us, PieceType Type>
+    void generatePieceMoves(const Board &board, Bitboard target, MoveList &moves)
+    {
+        Bitboard occupied = board.getOccupied();
+        Bitboard pieces = board.getPieces(Us, Type);
+        while (pieces)
+        {
+            Square from = (Square)popLowest(pieces);
+            Bitboard attacks;
+            if constexpr (Type == PieceType::KNIGHT)
+                attacks = knightAttacks(from);
+            else if constexpr (Type == PieceType::BISHOP)
+                attacks = bishopAttacks(from, occupied);
+            else if constexpr (Type == PieceType::ROOK)
+                attacks = rookAttacks(from, occupied);
+            else if constexpr (Type == PieceType::QUEEN)
+                attacks = queenAttacks(from, occupied);
+            else
+                attacks = kingAttacks(from);
+
+            attacks &= target;
+            while (attacks)
+                moves.push(Move(square(from), square(popLowest(attacks))));
+        }
+    }
+
+    template <Color Us, GenType Type>
+    void generateMoves(Board &board, MoveList &moves)
+    {
+        constexpr Color Them = Side<Us>::THEM;
+        Bitboard own = board.getPieces(Us);
+        Bitboard target;
+
+        if constexpr (Type == GenType::CAPTURES)
+        {
+            target = board.getPieces(Them);
+        }
+        else if constexpr (Type == GenType::QUIETS)
+        {
+            target = ~board.getOccupied();
+        }
+        else
+        {
+            // Block or capture a single checker; only the king can answer a double check
+            Position king = board.getKingPosition(Us);
+            Bitboard checkers = king.isValid() ? board.getAttackers(king, Them) : 0;
+            target = 0;
+            if (popCount(checkers) == 1)
+                target = checkers | betweenMask(king.getSquare(), (Square)__builtin_ctzll(checkers));
+        }
+
+        if (target)
+        {
+            generatePawnMoves<Us, Type>(board, target, moves);
+            generatePieceMoves<Us, PieceType::KNIGHT>(board, target, moves);
+            generatePieceMoves<Us, PieceType::BISHOP>(board, target, moves);
+            generatePieceMoves<Us, PieceType::ROOK>(board, target, moves);
+            generatePieceMoves<Us, PieceType::QUEEN>(board, target, moves);
+        }
+
+        if constexpr (Type == GenType::EVASIONS)
+            generatePieceMoves<Us, PieceType::KING>(board, ~own, moves);
+        else
+            generatePieceMoves<Us, PieceType::KING>(board, target, moves);
+
+        // Castling is encoded as the king moving two squares towards the rook
+        if constexpr (Type == GenType::QUIETS)
+        {
+            constexpr int row = (Us == Color::WHITE) ? 7 : 0;
+            if (SpecialMoves::canCastleKingSide(Us, board))
+                moves.push(Move(Position(row, 4), Position(row, 6)));
+            if (SpecialMoves::canCastleQueenSide(Us, board))
+                moves.push(Move(Position(row, 4), Position(row, 2)));
+        }
+    }
+
+    // Drops the moves from index start on that leave the king in check
+    void keepLegal(Board &board, MoveList &moves, int start)
+    {
+        int kept = start;
+        for (int i = start; i < moves.size(); i++)
+        {
+            if (MoveGen::isLegal(board, moves[i]))
+                moves[kept++] = moves[i];
+        }
+        moves.count = kept;
+    }
+
+    // Cheap filter for check generation: false only if the move cannot give check
+    template <Color Us>
+    bool mayGiveCheck(const Board &board, const Move &move, Square king)
+    {
+        Square from = move.getFrom().getSquare();
+        Square to = move.getTo().getSquare();
+
+        // Leaving a line through the enemy king may uncover a slider behind the piece
+        if (lineMask(from, king))
+            return true;
+
+        PieceType type = move.getPromotion() ? Piece::get(move.getPromotion(), Us)->getType()
+                                             : board.getPiece(move.getFrom())->getType();
+        Bitboard kingBit = 1ULL << king;
+        Bitboard occupied = (board.getOccupied() & ~(1ULL << from)) | (1ULL << to);
+        switch (type)
+        {
+        case PieceType::PAWN:
+            // An en passant capture also removes a pawn, which may uncover a check
+            return (pawnAttacks(Us, to) & kingBit) ||
+                   (move.getFrom().getCol() != move.getTo().getCol() && board.isEmpty(move.getTo()));
+        case PieceType::KNIGHT:
+            return knightAttacks(to) & kingBit;
+        case PieceType::BISHOP:
+            return bishopAttacks(to, occupied) & kingBit;
+        case PieceType::ROOK:
+            return rookAttacks(to, occupied) & kingBit;
+        case PieceType::QUEEN:
+            return queenAttacks(to, occupied) & kingBit;
+        default:
+            // Castling moves the rook, which may give check
+            return std::abs(move.getTo().getCol() - move.getFrom().getCol()) == 2;
+        }
+    }
+
+    // Drops the moves from index start on that are illegal or do not give check
+    template <Color Us>
+    void keepLegalChecks(Board &board, MoveList &moves, int start)
+    {
+        constexpr Color Them = Side<Us>::THEM;
+        Position theirKing = board.getKingPosition(Them);
+        int kept = start;
+        for (int i = start; theirKing.isValid() && i < moves.size(); i++)
+        {
+            Move move = moves[i];
+            if (!mayGiveCheck<Us>(board, move, theirKing.getSquare()))
+                continue;
+
+            MoveUndo undo = board.makeMove(move);
+            bool check = board.isInCheck(Them) && !board.isInCheck(Us);
+            board.unmakeMove(move, undo);
+            if (check)
+                moves[kept++] = move;
+        }
+        moves.count = kept;
+    }
+
+    template <Color Us>
+    void generateChecks(Board &board, MoveList &moves)
+    {
+        int start = moves.size();
+        if (board.isInCheck(Us))
+        {
+            generateMoves<Us, GenType::EVASIONS>(board, moves);
+        }
+        else
+        {
+            generateMoves<Us, GenType::CAPTURES>(board, moves);
+            generateMoves<Us, GenType::QUIETS>(board, moves);
+        }
+        keepLegalChecks<Us>(board, moves, start);
+    }
+
+    template <Color Us>
+    void generateLegalMoves(Board &board, MoveList &moves)
+    {
+        int start = moves.size();
+        if (board.isInCheck(Us))
+        {
+            generateMoves<Us, GenType::EVASIONS>(board, moves);
+        }
+        else
+        {
+            generateMoves<Us, GenType::CAPTURES>(board, moves);
+            generateMoves<Us, GenType::QUIETS>(board, moves);
+        }
+        keepLegal(board, moves, start);
+    }
+
+    template <Color Us>
+    void generateFor(GenType type, Board &board, MoveList &moves)
+    {
+        switch (type)
+        {
+        case GenType::CAPTURES:
+            generateMoves<Us, GenType::CAPTURES>(board, moves);
+            break;
+        case GenType::QUIETS:
+            generateMoves<Us, GenType::QUIETS>(board, moves);
+            break;
+        case GenType::EVASIONS:
+            generateMoves<Us, GenType::EVASIONS>(board, moves);
+            break;
+        case GenType::CHECKS:
+            generateChecks<Us>(board, moves);
+            break;
+        case GenType::LEGAL:
+            generateLegalMoves<Us>(board, moves);
+            break;
+        }
+    }
+}
+
+void MoveGen::generate(GenType type, Board &board, Color color, MoveList &moves)
+{
+    // The only runtime branch on color and type; everything below is specialized for both
+    if (color == Color::WHITE)
+        generateFor<Color::WHITE>(type, board, moves);
+    else
+        generateFor<Color::BLACK>(type, board, moves);
+}
+
+std::vector<Move> MoveGen::generatePseudoLegal(Board &board, Color color)
+{
+    MoveList moves;
+    generate(GenType::CAPTURES, board, color, moves);
+    generate(GenType::QUIETS, board, color, moves);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+std::vector<Move> MoveGen::generateLegal(Board &board, Color color)
+{
+    MoveList moves;
+    generate(GenType::LEGAL, board, color, moves);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+std::vector<Move> MoveGen::generateCaptures(Board &board, Color color)
+{
+    MoveList moves;
+    generate(GenType::CAPTURES, board, color, moves);
+    keepLegal(board, moves, 0);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+bool MoveGen::isLegal(Board &board, const Move &move)
+{
+    Color color = board.getPiece(move.getFrom())->getColor();
+    MoveUndo undo = board.makeMove(move);
+    bool legal = !board.isInCheck(color);
+    board.unmakeMove(move, undo);
+    return legal;
+}
+
+bool MoveGen::isCapture(const Board &board, const Move &move)
+{
+    if (!board.isEmpty(move.getTo()))
+        return true;
+
+    const Piece *piece = board.getPiece(move.getFrom());
+    return piece && piece->getType() == PieceType::PAWN && move.getFrom().getCol() != move.getTo().getCol();
+}
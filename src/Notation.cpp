@@ -0,0 +1,224 @@
+#include "Notation.h"
+#include "MoveGen.h"
+#include <cctype>
+#include <cstdlib>
+
+std::string Notation::toSan(Board &board, const Move &move)
+{
+    char buffer[MAX_SAN_LENGTH + 1];
+    size_t length = writeSan(board, move, buffer);
+    return std::string(buffer, length);
+}
+
+size_t Notation::writeSan(Board &board, const Move &move, char *out)
+{
+    Position from = move.getFrom();
+    Position to = move.getTo();
+    const Piece *piece = board.getPiece(from);
+    size_t n = 0;
+    if (!piece)
+    {
+        out[0] = '\0';
+        return 0;
+    }
+
+    Color color = piece->getColor();
+    char letter = piece->getLetter();
+
+    if (letter == 'K' && std::abs(to.getCol() - from.getCol()) == 2)
+    {
+        const char *castle = (to.getCol() == 6) ? "O-O" : "O-O-O";
+        while (*castle)
+            out[n++] = *castle++;
+    }
+    else
+    {
+        bool capture = MoveGen::isCapture(board, move);
+
+        if (letter == 'P')
+        {
+            if (capture)
+                out[n++] = (char)('a' + from.getCol());
+        }
+        else
+        {
+            out[n++] = letter;
+
+            // Disambiguate between identical pieces that can reach the same square
+            bool ambiguous = false, sameCol = false, sameRow = false;
+            for (const Move &other : MoveGen::generateLegal(board, color))
+            {
+                if (other.getTo() != to || other.getFrom() == from)
+                    continue;
+                const Piece *rival = board.getPiece(other.getFrom());
+                if (rival->getLetter() != letter)
+                    continue;
+
+                ambiguous = true;
+                if (other.getFrom().getCol() == from.getCol())
+                    sameCol = true;
+                if (other.getFrom().getRow() == from.getRow())
+                    sameRow = true;
+            }
+            if (ambiguous)
+            {
+                if (!sameCol)
+                    out[n++] = (char)('a' + from.getCol());
+                else if (!sameRow)
+                    out[n++] = (char)('0' + (8 - from.getRow()));
+                else
+                {
+                    out[n++] = (char)('a' + from.getCol());
+                    out[n++] = (char)('0' + (8 - from.getRow()));
+                }
+            }
+        }
+
+        if (capture)
+            out[n++] = 'x';
+        out[n++] = (char)('a' + to.getCol());
+        out[n++] = (char)('0' + (8 - to.getRow()));
+
+        if (move.getPromotion())
+        {
+            out[n++] = '=';
+            out[n++] = move.getPromotion();
+        }
+    }
+
+    // Append the check or checkmate marker
+    Color enemy = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    MoveUndo undo = board.makeMove(move);
+    if (board.isInCheck(enemy))
+    {
+        out[n++] = MoveGen::generateLegal(board, enemy).empty() ? '#' : '+';
+    }
+    board.unmakeMove(move, undo);
+
+    out[n] = '\0';
+    return n;
+}
+
+Move Notation::fromSan(Board &board, const std::string &san)
+{
+    std::string text = stripSan(san);
+    Color color = board.getSideToMove();
+    int homeRow = (color == Color::WHITE) ? 7 : 0;
+
+    char letter = 'P';
+    char promotion = 0;
+    int toRow = -1, toCol = -1, fromRow = -1, fromCol = -1;
+
+    if (text == "O-O" || text == "O-O-O")
+    {
+        letter = 'K';
+        fromRow = homeRow;
+        fromCol = 4;
+        toRow = homeRow;
+        toCol = (text == "O-O") ? 6 : 2;
+    }
+    else
+    {
+        size_t eq = text.find('=');
+        if (eq != std::string::npos)
+        {
+            if (eq + 1 >= text.length())
+                return Move();
+            promotion = (char)std::toupper((unsigned char)text[eq + 1]);
+            text.erase(eq);
+        }
+
+        size_t i = 0;
+        if (!text.empty() && std::string("NBRQK").find(text[0]) != std::string::npos)
+        {
+            letter = text[0];
+            i = 1;
+        }
+
+        std::string body;
+        for (; i < text.length(); i++)
+        {
+            if (text[i] != 'x' && text[i] != '-' && text[i] != ':')
+                body += text[i];
+        }
+        if (body.length() < 2 || body.length() > 4)
+            return Move();
+
+        char file = body[body.length() - 2];
+        char rank = body[body.length() - 1];
+        if (file < 'a' || file > 'h' || rank < '1' || rank > '8')
+            return Move();
+        toCol = file - 'a';
+        toRow = 8 - (rank - '0');
+
+        // Anything before the destination square disambiguates the source
+        for (size_t k = 0; k + 2 < body.length(); k++)
+        {
+            if (body[k] >= 'a' && body[k] <= 'h')
+                fromCol = body[k] - 'a';
+            else if (body[k] >= '1' && body[k] <= '8')
+                fromRow = 8 - (body[k] - '0');
+            else
+                return Move();
+        }
+    }
+
+    Move found;
+    for (const Move &move : MoveGen::generateLegal(board, color))
+    {
+        Position from = move.getFrom();
+        Position to = move.getTo();
+        if (to.getRow() != toRow || to.getCol() != toCol || move.getPromotion() != promotion)
+            continue;
+        if ((fromRow >= 0 && from.getRow() != fromRow) || (fromCol >= 0 && from.getCol() != fromCol))
+            continue;
+        if (board.getPiece(from)->getLetter() != letter)
+            continue;
+
+        // Two candidates means the SAN was ambiguous
+        if (!found.isNull())
+            return Move();
+        found = move;
+    }
+    return found;
+}
+
+Move Notation::fromUci(Board &board, const std::string &uci)
+{
+    if (uci.length() != 4 && uci.length() != 5)
+        return Move();
+
+    for (const Move &move : MoveGen::generateLegal(board, board.getSideToMove()))
+    {
+        std::string text = move.toUci();
+        if (text == uci || (uci.length() == 5 && text.substr(0, 4) == uci.substr(0, 4) &&
+                            text.length() == 5 && text[4] == std::tolower((unsigned char)uci[4])))
+            return move;
+    }
+    return Move();
+}
+
+std::string Notation::stripSan(const std::string &san)
+{
+    std::string result;
+    for (char c : san)
+    {
+        if (c == '+' || c == '#' || c == '!' || c == '?')
+            continue;
+        result += (c == '0') ? 'O' : c;
+    }
+
+    // Tolerate promotions written without '=' such as "e8Q"
+    size_t len = result.length();
+    if (len >= 3 && std::isupper((unsigned char)result[len - 1]) && std::isdigit((unsigned char)result[len - 2]) &&
+        result[0] >= 'a' && result[0] <= 'h')
+    {
+        result.insert(len - 1, "=");
+    }
+
+    // Drop an en passant suffix
+    if (result.size() > 4 && result.compare(result.size() - 4, 4, "e.p.") == 0)
+        result.erase(result.size() - 4);
+
+    return result;
+}
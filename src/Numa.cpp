@@ -0,0 +1,139 @@
+#include "Numa.h"
+#include <algorithm>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+    // Memory policies from <linux/mempolicy.h>, used through the raw system call
+    // so no libnuma is needed
+    const int MPOL_BIND_MODE = 2;
+    const int MPOL_INTERLEAVE_MODE = 3;
+    const int MASK_WORDS = 16;
+
+    // Parses a kernel CPU list such as "0-7,16-23"
+    std::vector<int> parseCpuList(const std::string &text)
+    {
+        std::vector<int> cpus;
+        size_t pos = 0;
+        while (pos < text.size())
+        {
+            size_t end = text.find(',', pos);
+            if (end == std::string::npos)
+                end = text.size();
+            std::string range = text.substr(pos, end - pos);
+            size_t dash = range.find('-');
+            if (!range.empty() && range[0] >= '0' && range[0] <= '9')
+            {
+                int first = std::atoi(range.c_str());
+                int last = (dash == std::string::npos) ? first : std::atoi(range.c_str() + dash + 1);
+                for (int cpu = first; cpu <= last; cpu++)
+                    cpus.push_back(cpu);
+            }
+            pos = end + 1;
+        }
+        return cpus;
+    }
+
+    std::vector<NumaNode> detectNodes()
+    {
+        std::vector<NumaNode> nodes;
+        if (DIR *dir = opendir("/sys/devices/system/node"))
+        {
+            while (dirent *entry = readdir(dir))
+            {
+                std::string name = entry->d_name;
+                if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                    name.find_first_not_of("0123456789", 4) != std::string::npos)
+                    continue;
+
+                std::ifstream file("/sys/devices/system/node/" + name + "/cpulist");
+                std::string list;
+                std::getline(file, list);
+
+                // Memory-only nodes have nothing to run threads on
+                NumaNode node;
+                node.id = std::atoi(name.c_str() + 4);
+                node.cpus = parseCpuList(list);
+                if (!node.cpus.empty())
+                    nodes.push_back(node);
+            }
+            closedir(dir);
+        }
+
+        if (nodes.empty())
+        {
+            NumaNode node;
+            unsigned count = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned cpu = 0; cpu < count; cpu++)
+                node.cpus.push_back((int)cpu);
+            nodes.push_back(node);
+        }
+
+        std::sort(nodes.begin(), nodes.end(), [](const NumaNode &a, const NumaNode &b)
+                  { return a.id < b.id; });
+        return nodes;
+    }
+
+    bool setPolicy(void *memory, size_t bytes, int mode, const unsigned long *mask)
+    {
+        return syscall(SYS_mbind, memory, bytes, mode, mask, (unsigned long)(MASK_WORDS * 64 + 1), 0) == 0;
+    }
+}
+
+const std::vector<NumaNode> &Numa::nodes()
+{
+    static const std::vector<NumaNode> detected = detectNodes();
+    return detected;
+}
+
+int Numa::nodeForThread(unsigned index, unsigned threads)
+{
+    if (threads == 0)
+        return 0;
+    return (int)((size_t)index * nodes().size() / threads);
+}
+
+bool Numa::pinThread(int node)
+{
+    if (!isMultiNode())
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : nodes()[node].cpus)
+        CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool Numa::bindMemory(void *memory, size_t bytes, int node)
+{
+    int id = nodes()[node].id;
+    if (!isMultiNode() || id >= MASK_WORDS * 64)
+        return false;
+
+    unsigned long mask[MASK_WORDS] = {};
+    mask[id / 64] |= 1UL << (id % 64);
+    return setPolicy(memory, bytes, MPOL_BIND_MODE, mask);
+}
+
+bool Numa::interleaveMemory(void *memory, size_t bytes)
+{
+    if (!isMultiNode())
+        return false;
+
+    unsigned long mask[MASK_WORDS] = {};
+    for (const NumaNode &node : nodes())
+    {
+        if (node.id < MASK_WORDS * 64)
+            mask[node.id / 64] |= 1UL << (node.id % 64);
+    }
+    return setPolicy(memory, bytes, MPOL_INTERLEAVE_MODE, mask);
+}
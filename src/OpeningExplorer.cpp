@@ -0,0 +1,203 @@
+#include "OpeningExplorer.h"
+#include "Notation.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cstdlib>
+
+OpeningExplorer::OpeningExplorer(int plies, size_t capacity)
+    : precomputedPlies(plies), cacheCapacity(std::max<size_t>(1, capacity))
+{
+}
+
+bool OpeningExplorer::addGame(const PgnGame &game)
+{
+    GameRecord record;
+    if (game.result == "1-0")
+        record.result = 'W';
+    else if (game.result == "0-1")
+        record.result = 'B';
+    else if (game.result == "1/2-1/2")
+        record.result = 'D';
+    else
+        record.result = '*';
+
+    int whiteElo = std::atoi(game.getTag("WhiteElo").c_str());
+    int blackElo = std::atoi(game.getTag("BlackElo").c_str());
+    record.rating = (whiteElo > 0 && blackElo > 0) ? (uint16_t)((whiteElo + blackElo) / 2) : 0;
+
+    Board board;
+    std::string fen = game.getTag("FEN");
+    if (fen.empty())
+        board.initialize();
+    else if (!board.loadFEN(fen))
+        return false;
+
+    // Replay the whole game first so an illegal move leaves the index untouched
+    std::vector<uint64_t> keys;
+    keys.reserve(game.moves.size());
+    record.moves.reserve(game.moves.size());
+    for (const std::string &san : game.moves)
+    {
+        Move move = Notation::fromSan(board, san);
+        if (move.isNull())
+            return false;
+        keys.push_back(Zobrist::hash(board));
+        record.moves.push_back(move);
+        board.makeMove(move);
+    }
+
+    uint32_t index = (uint32_t)games.size();
+    games.push_back(std::move(record));
+    const GameRecord &stored = games.back();
+
+    for (size_t ply = 0; ply < keys.size(); ply++)
+    {
+        if ((int)ply < precomputedPlies)
+            accumulate(precomputed[keys[ply]], stored.moves[ply], stored);
+        else
+            occurrences[keys[ply]].push_back(Occurrence{index, (uint16_t)ply});
+    }
+
+    // Cached aggregates may now be stale
+    cache.clear();
+    cacheIndex.clear();
+    return true;
+}
+
+void OpeningExplorer::finalize()
+{
+    for (auto it = occurrences.begin(); it != occurrences.end();)
+    {
+        auto pre = precomputed.find(it->first);
+        if (pre == precomputed.end())
+        {
+            ++it;
+            continue;
+        }
+
+        // A deep transposition into an early position joins the precomputed aggregate
+        for (const Occurrence &occurrence : it->second)
+        {
+            const GameRecord &record = games[occurrence.game];
+            accumulate(pre->second, record.moves[occurrence.ply], record);
+        }
+        it = occurrences.erase(it);
+    }
+
+    for (auto &entry : precomputed)
+    {
+        std::stable_sort(entry.second.begin(), entry.second.end(), [](const MoveStats &a, const MoveStats &b)
+                         { return a.games > b.games; });
+    }
+
+    cache.clear();
+    cacheIndex.clear();
+}
+
+std::vector<MoveStats> OpeningExplorer::query(Board &board)
+{
+    uint64_t key = Zobrist::hash(board);
+    StatsList result;
+
+    auto pre = precomputed.find(key);
+    if (pre != precomputed.end())
+    {
+        nameMoves(pre->second, board);
+        result = pre->second;
+    }
+
+    auto occ = occurrences.find(key);
+    if (occ != occurrences.end())
+    {
+        for (const MoveStats &deep : cachedAggregate(key, occ->second, board))
+        {
+            auto same = std::find_if(result.begin(), result.end(), [&](const MoveStats &stats)
+                                     { return stats.move == deep.move; });
+            if (same == result.end())
+            {
+                result.push_back(deep);
+                continue;
+            }
+            same->games += deep.games;
+            same->whiteWins += deep.whiteWins;
+            same->draws += deep.draws;
+            same->blackWins += deep.blackWins;
+            same->ratingSum += deep.ratingSum;
+            same->ratedGames += deep.ratedGames;
+        }
+
+        std::stable_sort(result.begin(), result.end(), [](const MoveStats &a, const MoveStats &b)
+                         { return a.games > b.games; });
+    }
+
+    return result;
+}
+
+void OpeningExplorer::accumulate(StatsList &stats, const Move &move, const GameRecord &record)
+{
+    auto it = std::find_if(stats.begin(), stats.end(), [&](const MoveStats &entry)
+                           { return entry.move == move; });
+    if (it == stats.end())
+    {
+        stats.emplace_back();
+        it = stats.end() - 1;
+        it->move = move;
+    }
+
+    it->games++;
+    if (record.result == 'W')
+        it->whiteWins++;
+    else if (record.result == 'B')
+        it->blackWins++;
+    else if (record.result == 'D')
+        it->draws++;
+
+    if (record.rating)
+    {
+        it->ratingSum += record.rating;
+        it->ratedGames++;
+    }
+}
+
+void OpeningExplorer::nameMoves(StatsList &stats, Board &board)
+{
+    for (MoveStats &entry : stats)
+    {
+        if (entry.san.empty())
+            entry.san = Notation::toSan(board, entry.move);
+    }
+}
+
+OpeningExplorer::StatsList OpeningExplorer::aggregate(const std::vector<Occurrence> &list) const
+{
+    StatsList stats;
+    for (const Occurrence &occurrence : list)
+    {
+        const GameRecord &record = games[occurrence.game];
+        accumulate(stats, record.moves[occurrence.ply], record);
+    }
+    return stats;
+}
+
+const OpeningExplorer::StatsList &OpeningExplorer::cachedAggregate(uint64_t key, const std::vector<Occurrence> &list, Board &board)
+{
+    auto cached = cacheIndex.find(key);
+    if (cached != cacheIndex.end())
+    {
+        // Move the hit to the front so it is evicted last
+        cache.splice(cache.begin(), cache, cached->second);
+        return cached->second->second;
+    }
+
+    StatsList stats = aggregate(list);
+    nameMoves(stats, board);
+    cache.emplace_front(key, std::move(stats));
+    cacheIndex[key] = cache.begin();
+
+    if (cache.size() > cacheCapacity)
+    {
+        cacheIndex.erase(cache.back().first);
+        cache.pop_back();
+    }
+    return cache.front().second;
+}
@@ -0,0 +1,146 @@
+#include "Pgn.h"
+#include <cctype>
+
+namespace
+{
+    // Parses a tag pair line such as [White "Kasparov, Garry"]
+    bool parseTag(const std::string &line, std::pair<std::string, std::string> &tag)
+    {
+        size_t nameStart = line.find('[');
+        size_t quote = line.find('"');
+        if (nameStart == std::string::npos || quote == std::string::npos)
+            return false;
+
+        std::string name = line.substr(nameStart + 1, quote - nameStart - 1);
+        while (!name.empty() && std::isspace((unsigned char)name.back()))
+            name.pop_back();
+
+        std::string value;
+        for (size_t i = quote + 1; i < line.length() && line[i] != '"'; i++)
+        {
+            if (line[i] == '\\' && i + 1 < line.length())
+                i++;
+            value += line[i];
+        }
+
+        tag = std::make_pair(name, value);
+        return !name.empty();
+    }
+
+    bool isResult(const std::string &token)
+    {
+        return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+    }
+}
+
+std::string PgnGame::getTag(const std::string &name) const
+{
+    for (const auto &tag : tags)
+    {
+        if (tag.first == name)
+            return tag.second;
+    }
+    return "";
+}
+
+bool PgnReader::readLine(std::string &line)
+{
+    if (hasPendingLine)
+    {
+        line = pendingLine;
+        hasPendingLine = false;
+        return true;
+    }
+    if (!std::getline(input, line))
+        return false;
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+    return true;
+}
+
+bool PgnReader::next(PgnGame &game)
+{
+    game = PgnGame();
+
+    std::string line;
+    bool inMovetext = false;
+    bool inComment = false;
+    int variationDepth = 0;
+    bool sawAnything = false;
+
+    while (readLine(line))
+    {
+        if (!line.empty() && line[0] == '%')
+            continue;
+        if (!sawAnything && line.find_first_not_of(" \t") == std::string::npos)
+            continue;
+
+        // A tag after the movetext has started belongs to the next game
+        if (!inComment && !line.empty() && line[0] == '[')
+        {
+            if (inMovetext)
+            {
+                pendingLine = line;
+                hasPendingLine = true;
+                return true;
+            }
+            game.text += line + "\n";
+            std::pair<std::string, std::string> tag;
+            if (parseTag(line, tag))
+                game.tags.push_back(tag);
+            sawAnything = true;
+            continue;
+        }
+
+        game.text += line + "\n";
+        std::string token;
+        for (size_t i = 0; i <= line.length(); i++)
+        {
+            char c = (i < line.length()) ? line[i] : ' ';
+
+            if (inComment)
+            {
+                if (c == '}')
+                    inComment = false;
+                continue;
+            }
+            if (c == '{' || c == ';' || c == '(' || c == ')' || std::isspace((unsigned char)c))
+            {
+                if (!token.empty())
+                {
+                    inMovetext = true;
+                    sawAnything = true;
+                    if (variationDepth == 0)
+                    {
+                        if (isResult(token))
+                        {
+                            game.result = token;
+                            return true;
+                        }
+
+                        // Strip move numbers such as "12." or "12..." glued to the move
+                        size_t start = 0;
+                        while (start < token.length() && (std::isdigit((unsigned char)token[start]) || token[start] == '.'))
+                            start++;
+                        if (start < token.length() && token[0] != '$' && token.compare(start, std::string::npos, "--") != 0)
+                            game.moves.push_back(token.substr(start));
+                    }
+                    token.clear();
+                }
+
+                if (c == '{')
+                    inComment = true;
+                else if (c == ';')
+                    break;
+                else if (c == '(')
+                    variationDepth++;
+                else if (c == ')' && variationDepth > 0)
+                    variationDepth--;
+                continue;
+            }
+            token += c;
+        }
+    }
+
+    return sawAnything;
+}
@@ -0,0 +1,184 @@
+#include "PgnWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    const size_t MAX_LINE_LENGTH = 79;
+
+    std::string today()
+    {
+        char date[16];
+        std::time_t now = std::time(nullptr);
+        std::tm local = *std::localtime(&now);
+        std::strftime(date, sizeof(date), "%Y.%m.%d", &local);
+        return date;
+    }
+
+    // Formats "12." into out and returns its length
+    size_t formatMoveNumber(size_t number, char *out)
+    {
+        char digits[20];
+        size_t count = 0;
+        do
+        {
+            digits[count++] = (char)('0' + number % 10);
+            number /= 10;
+        } while (number);
+
+        size_t n = 0;
+        while (count)
+            out[n++] = digits[--count];
+        out[n++] = '.';
+        return n;
+    }
+
+    // Reads the side to move and fullmove number fields of a FEN, keeping the defaults if missing
+    void readMoveCounters(const std::string &fen, bool &blackToMove, size_t &fullmoveNumber)
+    {
+        std::istringstream fields(fen);
+        std::string placement, side, castling, enPassant, halfmoves, fullmoves;
+        fields >> placement >> side >> castling >> enPassant >> halfmoves >> fullmoves;
+        blackToMove = side == "b";
+        long number = std::atol(fullmoves.c_str());
+        if (number > 0)
+            fullmoveNumber = (size_t)number;
+    }
+}
+
+PgnWriter::PgnWriter(const std::string &path, size_t bufferSize)
+    : file(std::fopen(path.c_str(), "ab")), buffer(new char[bufferSize < 4096 ? 4096 : bufferSize]),
+      capacity(bufferSize < 4096 ? 4096 : bufferSize), used(0)
+{
+    if (!file)
+        throw std::runtime_error("Cannot open PGN file: " + path);
+
+    // The buffer below already batches writes
+    std::setvbuf(file, nullptr, _IONBF, 0);
+}
+
+PgnWriter::~PgnWriter()
+{
+    flush();
+    std::fclose(file);
+}
+
+void PgnWriter::append(const char *data, size_t length)
+{
+    while (length)
+    {
+        if (used == capacity)
+            flushLocked();
+
+        size_t chunk = std::min(length, capacity - used);
+        std::memcpy(buffer.get() + used, data, chunk);
+        used += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+void PgnWriter::appendTag(const char *name, const std::string &value)
+{
+    append("[", 1);
+    append(name, std::strlen(name));
+    append(" \"", 2);
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            append("\\", 1);
+        append(&c, 1);
+    }
+    append("\"]\n", 3);
+}
+
+void PgnWriter::writeGame(const PgnHeader &header, const MoveRecord *moves, size_t count,
+                          const std::string *annotations)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    appendTag("Event", header.event);
+    appendTag("Site", header.site);
+    appendTag("Date", header.date.empty() ? today() : header.date);
+    appendTag("Round", header.round);
+    appendTag("White", header.white);
+    appendTag("Black", header.black);
+    appendTag("Result", header.result);
+    if (!header.fen.empty())
+    {
+        appendTag("SetUp", "1");
+        appendTag("FEN", header.fen);
+    }
+    append("\n", 1);
+
+    // Each token is written with a leading separator, wrapping lines before they get too long
+    size_t lineLength = 0;
+    auto token = [&](const char *text, size_t length)
+    {
+        if (lineLength && lineLength + 1 + length > MAX_LINE_LENGTH)
+        {
+            append("\n", 1);
+            lineLength = 0;
+        }
+        else if (lineLength)
+        {
+            append(" ", 1);
+            lineLength++;
+        }
+        append(text, length);
+        lineLength += length;
+    };
+
+    // Numbering continues from the starting position's move, as in "23..." with Black to move
+    bool blackFirst = false;
+    size_t firstMove = 1;
+    if (!header.fen.empty())
+        readMoveCounters(header.fen, blackFirst, firstMove);
+    char number[24];
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t ply = i + (blackFirst ? 1 : 0);
+        if (ply % 2 == 0 || i == 0)
+        {
+            size_t length = formatMoveNumber(firstMove + ply / 2, number);
+            if (ply % 2)
+            {
+                std::memcpy(number + length, "..", 2);
+                length += 2;
+            }
+            token(number, length);
+        }
+        token(moves[i].san, std::strlen(moves[i].san));
+
+        // Split annotations into words so long comments wrap like everything else
+        const std::string *annotation = annotations ? &annotations[i] : nullptr;
+        for (size_t begin = 0; annotation && begin < annotation->size();)
+        {
+            size_t end = annotation->find(' ', begin);
+            if (end == std::string::npos)
+                end = annotation->size();
+            if (end > begin)
+                token(annotation->data() + begin, end - begin);
+            begin = end + 1;
+        }
+    }
+    token(header.result.c_str(), header.result.length());
+    append("\n\n", 2);
+}
+
+void PgnWriter::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    flushLocked();
+}
+
+void PgnWriter::flushLocked()
+{
+    if (used)
+        std::fwrite(buffer.get(), 1, used, file);
+    used = 0;
+}
@@ -1,71 +1,63 @@
 #include "Pieces.h"
 #include "Board.h"
+#include "Attacks.h"
 #include <cmath>
 
-std::string Piece::getSymbol() const
+namespace
 {
-    // Unicode chess pieces
-    // White pieces: ♔ ♕ ♖ ♗ ♘ ♙
-    // Black pieces: ♚ ♛ ♜ ♝ ♞ ♟
-    if (color == Color::WHITE)
-    {
-        switch (symbol)
-        {
-        case 'K':
-            return "♔"; // White King
-        case 'Q':
-            return "♕"; // White Queen
-        case 'R':
-            return "♖"; // White Rook
-        case 'B':
-            return "♗"; // White Bishop
-        case 'N':
-            return "♘"; // White Knight
-        case 'P':
-            return "♙"; // White Pawn
-        default:
-            return "?";
-        }
-    }
-    else
+    // One shared instance per piece type and color
+    const Pawn whitePawn(Color::WHITE), blackPawn(Color::BLACK);
+    const Knight whiteKnight(Color::WHITE), blackKnight(Color::BLACK);
+    const Bishop whiteBishop(Color::WHITE), blackBishop(Color::BLACK);
+    const Rook whiteRook(Color::WHITE), blackRook(Color::BLACK);
+    const Queen whiteQueen(Color::WHITE), blackQueen(Color::BLACK);
+    const King whiteKing(Color::WHITE), blackKing(Color::BLACK);
+
+    // True if the square holds a piece of the given color
+    bool isOwnPiece(const Board &board, Color color, Square square)
     {
-        switch (symbol)
-        {
-        case 'K':
-            return "♚"; // Black King
-        case 'Q':
-            return "♛"; // Black Queen
-        case 'R':
-            return "♜"; // Black Rook
-        case 'B':
-            return "♝"; // Black Bishop
-        case 'N':
-            return "♞"; // Black Knight
-        case 'P':
-            return "♟"; // Black Pawn
-        default:
-            return "?";
-        }
+        return board.getPieces(color) & (1ULL << square);
     }
 }
 
-bool Pawn::isValidMove(const Position &to, const Board &board) const
+const Piece *Piece::get(char letter, Color color)
+{
+    int type = pieceTypeIndex(letter);
+    return type < 0 ? nullptr : get((PieceType)type, color);
+}
+
+const Piece *Piece::get(PieceType type, Color color)
 {
-    int rowDiff = to.getRow() - position.getRow();
-    int colDiff = std::abs(to.getCol() - position.getCol());
+    static const Piece *const pieces[2][PIECE_TYPE_COUNT] = {
+        {&whitePawn, &whiteKnight, &whiteBishop, &whiteRook, &whiteQueen, &whiteKing},
+        {&blackPawn, &blackKnight, &blackBishop, &blackRook, &blackQueen, &blackKing}};
+    return pieces[(int)color][(int)type];
+}
+
+std::string Piece::getSymbol() const
+{
+    return getGlyph();
+}
+
+bool Pawn::isValidMove(const Position &from, const Position &to, const Board &board) const
+{
+    Square f = from.getSquare(), t = to.getSquare();
+    int rowDiff = rowOf(t) - rowOf(f);
+    int colDiff = std::abs(colOf(t) - colOf(f));
     int direction = (color == Color::WHITE) ? -1 : 1;
+    bool targetEmpty = !(board.getOccupied() & (1ULL << t));
 
     // Move forward one square
-    if (colDiff == 0 && rowDiff == direction && board.isEmpty(to))
+    if (colDiff == 0 && rowDiff == direction && targetEmpty)
     {
         return true;
     }
 
     // Move forward two squares from starting position
-    if (colDiff == 0 && !hasMoved && rowDiff == 2 * direction)
+    int startRow = (color == Color::WHITE) ? 6 : 1;
+    if (colDiff == 0 && rowOf(f) == startRow && rowDiff == 2 * direction)
     {
-        Position middle(position.getRow() + direction, position.getCol());
-        if (board.isEmpty(middle) && board.isEmpty(to))
+        if (!(betweenMask(f, t) & board.getOccupied()) && targetEmpty)
         {
             return true;
         }
@@ -74,7 +66,7 @@ bool Pawn::isValidMove(const Position &to, const Board &board) const
     // Capture diagonally
     if (colDiff == 1 && rowDiff == direction)
     {
-        if (!board.isEmpty(to) && board.getPiece(to)->getColor() != color)
+        if (!targetEmpty && !isOwnPiece(board, color, t))
         {
             return true;
         }
@@ -88,131 +80,94 @@ bool Pawn::isValidMove(const Position &to, const Board &board) const
     return false;
 }
 
-bool Rook::isValidMove(const Position &to, const Board &board) const
+bool Rook::isValidMove(const Position &from, const Position &to, const Board &board) const
 {
-    if (position == to)
+    Square f = from.getSquare(), t = to.getSquare();
+    if (f == t)
         return false;
 
     // Must move in straight line (horizontal or vertical)
-    if (position.getRow() != to.getRow() && position.getCol() != to.getCol())
+    if (!((SQUARE_TABLES.rank[f] | SQUARE_TABLES.file[f]) & (1ULL << t)))
     {
         return false;
     }
 
     // Check if path is clear
-    if (!board.isPathClear(position, to))
+    if (betweenMask(f, t) & board.getOccupied())
     {
         return false;
     }
 
     // Check destination
-    if (!board.isEmpty(to) && board.getPiece(to)->getColor() == color)
-    {
-        return false;
-    }
-
-    return true;
+    return !isOwnPiece(board, color, t);
 }
 
-bool Knight::isValidMove(const Position &to, const Board &board) const
+bool Knight::isValidMove(const Position &from, const Position &to, const Board &board) const
 {
-    int rowDiff = std::abs(to.getRow() - position.getRow());
-    int colDiff = std::abs(to.getCol() - position.getCol());
+    Square f = from.getSquare(), t = to.getSquare();
 
     // L-shape movement
-    if (!((rowDiff == 2 && colDiff == 1) || (rowDiff == 1 && colDiff == 2)))
+    if (!(knightAttacks(f) & (1ULL << t)))
     {
         return false;
     }
 
     // Check destination
-    if (!board.isEmpty(to) && board.getPiece(to)->getColor() == color)
-    {
-        return false;
-    }
-
-    return true;
+    return !isOwnPiece(board, color, t);
 }
 
-bool Bishop::isValidMove(const Position &to, const Board &board) const
+bool Bishop::isValidMove(const Position &from, const Position &to, const Board &board) const
 {
-    if (position == to)
+    Square f = from.getSquare(), t = to.getSquare();
+    if (f == t)
         return false;
 
-    int rowDiff = std::abs(to.getRow() - position.getRow());
-    int colDiff = std::abs(to.getCol() - position.getCol());
-
     // Must move diagonally
-    if (rowDiff != colDiff)
+    if (!((SQUARE_TABLES.diagonal[f] | SQUARE_TABLES.antiDiagonal[f]) & (1ULL << t)))
     {
         return false;
     }
 
     // Check if path is clear
-    if (!board.isPathClear(position, to))
+    if (betweenMask(f, t) & board.getOccupied())
     {
         return false;
     }
 
     // Check destination
-    if (!board.isEmpty(to) && board.getPiece(to)->getColor() == color)
-    {
-        return false;
-    }
-
-    return true;
+    return !isOwnPiece(board, color, t);
 }
 
-bool Queen::isValidMove(const Position &to, const Board &board) const
+bool Queen::isValidMove(const Position &from, const Position &to, const Board &board) const
 {
-    if (position == to)
-        return false;
-
-    int rowDiff = std::abs(to.getRow() - position.getRow());
-    int colDiff = std::abs(to.getCol() - position.getCol());
+    Square f = from.getSquare(), t = to.getSquare();
 
     // Must move in straight line or diagonal
-    if (rowDiff != colDiff && position.getRow() != to.getRow() && position.getCol() != to.getCol())
+    if (!lineMask(f, t))
     {
         return false;
     }
 
     // Check if path is clear
-    if (!board.isPathClear(position, to))
+    if (betweenMask(f, t) & board.getOccupied())
     {
         return false;
     }
 
     // Check destination
-    if (!board.isEmpty(to) && board.getPiece(to)->getColor() == color)
-    {
-        return false;
-    }
-
-    return true;
+    return !isOwnPiece(board, color, t);
 }
 
-bool King::isValidMove(const Position &to, const Board &board) const
+bool King::isValidMove(const Position &from, const Position &to, const Board &board) const
 {
-    int rowDiff = std::abs(to.getRow() - position.getRow());
-    int colDiff = std::abs(to.getCol() - position.getCol());
+    Square f = from.getSquare(), t = to.getSquare();
 
     // Must move one square in any direction
-    if (rowDiff > 1 || colDiff > 1)
-    {
-        return false;
-    }
-
-    if (rowDiff == 0 && colDiff == 0)
+    if (!(kingAttacks(f) & (1ULL << t)))
     {
         return false;
     }
 
     // Check destination
-    if (!board.isEmpty(to) && board.getPiece(to)->getColor() == color)
-    {
-        return false;
-    }
-
-    return true;
-}
\ No newline at end of file
+    return !isOwnPiece(board, color, t);
+}
@@ -1,18 +1,19 @@
 #include "Player.h"
 
 Player::Player()
-    : name(""), color(Color::WHITE), isInCheck(false), score(0), capturedPieceValue(0)
+    : name(""), color(Color::WHITE), isInCheck(false), score(0), capturedPieceValue(0), clockMs(0)
 {
 }
 
 Player::Player(const std::string &playerName, Color playerColor)
-    : name(playerName), color(playerColor), isInCheck(false), score(0), capturedPieceValue(0)
+    : name(playerName), color(playerColor), isInCheck(false), score(0), capturedPieceValue(0), clockMs(0)
 {
 }
 
 Player::Player(const Player &other)
     : name(other.name), color(other.color), isInCheck(other.isInCheck),
-      score(other.score), capturedPieceValue(other.capturedPieceValue)
+      score(other.score), capturedPieceValue(other.capturedPieceValue), premove(other.premove),
+      clockMs(other.clockMs)
 {
 }
 
@@ -25,6 +26,8 @@ Player &Player::operator=(const Player &other)
         isInCheck = other.isInCheck;
         score = other.score;
         capturedPieceValue = other.capturedPieceValue;
+        premove = other.premove;
+        clockMs = other.clockMs;
     }
     return *this;
 }
@@ -93,9 +96,38 @@ bool Player::isBlack() const
     return color == Color::BLACK;
 }
 
+void Player::setPremove(const Move &move)
+{
+    premove = move;
+}
+
+bool Player::hasPremove() const
+{
+    return !premove.isNull();
+}
+
+Move Player::takePremove()
+{
+    Move move = premove;
+    premove = Move();
+    return move;
+}
+
+int64_t Player::getClockMs() const
+{
+    return clockMs;
+}
+
+void Player::addClockMs(int64_t ms)
+{
+    clockMs += ms;
+}
+
 void Player::reset()
 {
     isInCheck = false;
     score = 0;
     capturedPieceValue = 0;
+    premove = Move();
+    clockMs = 0;
 }
@@ -0,0 +1,326 @@
+#include "Search.h"
+#include "AllocGuard.h"
+#include "Evaluation.h"
+#include <algorithm>
+
+namespace
+{
+    // Mate scores are stored relative to the stored position rather than the root
+    int scoreToTable(int score, int ply)
+    {
+        if (score > Search::MATE_SCORE - Search::MAX_PLY)
+            return score + ply;
+        if (score < -Search::MATE_SCORE + Search::MAX_PLY)
+            return score - ply;
+        return score;
+    }
+
+    int scoreFromTable(int score, int ply)
+    {
+        if (score > Search::MATE_SCORE - Search::MAX_PLY)
+            return score - ply;
+        if (score < -Search::MATE_SCORE + Search::MAX_PLY)
+            return score + ply;
+        return score;
+    }
+}
+
+Search::Search()
+    : stopped(false), sharedStop(nullptr), table(nullptr), copyMake(true), nodes(0), reusedNodes(0), rootDepth(0),
+      frames(new Frame[MAX_PLY + 1]), previousPvLength(0)
+{
+}
+
+SearchInfo Search::run(Board &board, const SearchLimits &searchLimits,
+                       const std::function<void(const SearchInfo &)> &onIteration)
+{
+    limits = searchLimits;
+    stopped = false;
+    nodes = 0;
+    reusedNodes = 0;
+    previousPvLength = 0;
+    for (int ply = 0; ply <= MAX_PLY; ply++)
+        frames[ply].killers[0] = frames[ply].killers[1] = Move();
+    startTime = std::chrono::steady_clock::now();
+
+    SearchInfo result;
+    result.pv.reserve(MAX_PLY);
+
+    MoveList rootMoves;
+    MoveGen::generate(GenType::LEGAL, board, board.getSideToMove(), rootMoves);
+    if (rootMoves.empty())
+    {
+        result.score = board.isInCheck(board.getSideToMove()) ? -MATE_SCORE : 0;
+        return result;
+    }
+    result.pv.push_back(rootMoves[0]);
+
+    int maxDepth = std::min(limits.depth, MAX_PLY - 1);
+    for (rootDepth = 1; rootDepth <= maxDepth; rootDepth++)
+    {
+        int score;
+        {
+            AllocationGuard guard;
+            score = negamax(board, rootDepth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+        }
+        if (stopped)
+            break;
+
+        const Frame &root = frames[0];
+        result.depth = rootDepth;
+        result.score = score;
+        result.nodes = nodes;
+        result.timeMs = elapsedMs();
+        result.pv.assign(root.pv, root.pv + root.pvLength);
+        std::copy(root.pv, root.pv + root.pvLength, previousPv);
+        previousPvLength = root.pvLength;
+
+        if (onIteration)
+            onIteration(result);
+
+        // A forced mate will not change with deeper search
+        if (isMateScore(score) && MATE_SCORE - std::abs(score) <= rootDepth)
+            break;
+    }
+
+    result.nodes = nodes;
+    result.timeMs = elapsedMs();
+    return result;
+}
+
+int Search::negamax(Board &board, int depth, int ply, int alpha, int beta)
+{
+    Frame &frame = frames[ply];
+    frame.pvLength = 0;
+    if (checkLimits())
+        return 0;
+
+    Color us = board.getSideToMove();
+    bool inCheck = board.isInCheck(us);
+
+    // Extend checks so forcing lines are resolved before quiescence
+    if (inCheck)
+        depth++;
+
+    if (depth <= 0 || ply >= MAX_PLY - 1)
+        return quiescence(board, ply, alpha, beta);
+
+    nodes++;
+
+    // A result from an earlier or parallel search of this position may settle it outright
+    uint64_t key = 0;
+    Move ttMove;
+    if (table)
+    {
+        key = board.getKey();
+        TTData entry;
+        if (table->probe(key, entry))
+        {
+            if (entry.carried)
+                reusedNodes++;
+            ttMove = entry.move;
+            int score = scoreFromTable(entry.score, ply);
+            if (ply > 0 && entry.depth >= depth &&
+                (entry.bound == Bound::EXACT ||
+                 (entry.bound == Bound::LOWER && score >= beta) ||
+                 (entry.bound == Bound::UPPER && score <= alpha)))
+                return score;
+        }
+    }
+
+    frame.moves.clear();
+    MoveGen::generate(GenType::LEGAL, board, us, frame.moves);
+    if (frame.moves.empty())
+        return inCheck ? -MATE_SCORE + ply : 0;
+    if (board.getHalfmoveClock() >= 100)
+        return 0;
+
+    scoreMoves(board, frame, ply, ttMove);
+
+    const Frame &child = frames[ply + 1];
+    int originalAlpha = alpha;
+    int best = -INFINITE_SCORE;
+    Move bestMove;
+    for (int i = 0; i < frame.moves.size(); i++)
+    {
+        Move move = pickMove(frame, i);
+
+        bool quiet = !MoveGen::isCapture(board, move) && !move.getPromotion();
+        int score;
+        if (copyMake)
+        {
+            Board next = board;
+            next.makeMove(move);
+            score = -negamax(next, depth - 1, ply + 1, -beta, -alpha);
+        }
+        else
+        {
+            MoveUndo undo = board.makeMove(move);
+            score = -negamax(board, depth - 1, ply + 1, -beta, -alpha);
+            board.unmakeMove(move, undo);
+        }
+
+        if (stopped)
+            return 0;
+
+        if (score > best)
+        {
+            best = score;
+            bestMove = move;
+            if (score > alpha)
+            {
+                alpha = score;
+                frame.pv[0] = move;
+                std::copy(child.pv, child.pv + child.pvLength, frame.pv + 1);
+                frame.pvLength = child.pvLength + 1;
+            }
+        }
+        if (alpha >= beta)
+        {
+            // Remember quiet refutations; they are likely to refute sibling positions too
+            if (quiet && move != frame.killers[0])
+            {
+                frame.killers[1] = frame.killers[0];
+                frame.killers[0] = move;
+            }
+            break;
+        }
+    }
+
+    if (table)
+    {
+        TTData entry;
+        entry.move = bestMove;
+        entry.score = scoreToTable(best, ply);
+        entry.depth = depth;
+        entry.bound = (best >= beta) ? Bound::LOWER : (best > originalAlpha ? Bound::EXACT : Bound::UPPER);
+        table->store(key, entry);
+    }
+
+    return best;
+}
+
+int Search::quiescence(Board &board, int ply, int alpha, int beta)
+{
+    Frame &frame = frames[ply];
+    frame.pvLength = 0;
+    if (checkLimits())
+        return 0;
+    nodes++;
+
+    frame.staticEval = Evaluation::evaluate(board);
+    if (frame.staticEval >= beta || ply >= MAX_PLY - 1)
+        return frame.staticEval;
+    if (frame.staticEval > alpha)
+        alpha = frame.staticEval;
+
+    frame.moves.clear();
+    MoveGen::generate(GenType::CAPTURES, board, board.getSideToMove(), frame.moves);
+    scoreMoves(board, frame, ply, Move());
+
+    for (int i = 0; i < frame.moves.size(); i++)
+    {
+        Move move = pickMove(frame, i);
+        if (!MoveGen::isLegal(board, move))
+            continue;
+
+        int score;
+        if (copyMake)
+        {
+            Board next = board;
+            next.makeMove(move);
+            score = -quiescence(next, ply + 1, -beta, -alpha);
+        }
+        else
+        {
+            MoveUndo undo = board.makeMove(move);
+            score = -quiescence(board, ply + 1, -beta, -alpha);
+            board.unmakeMove(move, undo);
+        }
+
+        if (stopped)
+            return 0;
+
+        if (score > alpha)
+        {
+            alpha = score;
+            if (alpha >= beta)
+                break;
+        }
+    }
+
+    return alpha;
+}
+
+void Search::scoreMoves(const Board &board, Frame &frame, int ply, const Move &ttMove) const
+{
+    Move pvMove = (ply < previousPvLength) ? previousPv[ply] : Move();
+
+    // Previous principal variation first, then the table's move, then captures by most valuable
+    // victim / least valuable attacker, then killer moves
+    for (int i = 0; i < frame.moves.size(); i++)
+    {
+        const Move &move = frame.moves[i];
+        int value = 0;
+        const Piece *victim = board.getPiece(move.getTo());
+        if (move == pvMove)
+            value = 1000000;
+        else if (move == ttMove)
+            value = 900000;
+        else if (victim)
+            value = 10 * seeValue(victim->getType()) - seeValue(board.getPiece(move.getFrom())->getType()) / 100;
+        else if (move == frame.killers[0])
+            value = 800;
+        else if (move == frame.killers[1])
+            value = 700;
+        if (move.getPromotion() == 'Q')
+            value += 8000;
+        frame.scores[i] = value;
+    }
+}
+
+const Move &Search::pickMove(Frame &frame, int index) const
+{
+    // Selection sort one step at a time: most nodes cut off after the first few moves
+    int best = index;
+    for (int i = index + 1; i < frame.moves.size(); i++)
+    {
+        if (frame.scores[i] > frame.scores[best])
+            best = i;
+    }
+    if (best != index)
+    {
+        std::swap(frame.moves[best], frame.moves[index]);
+        std::swap(frame.scores[best], frame.scores[index]);
+    }
+    return frame.moves[index];
+}
+
+bool Search::checkLimits()
+{
+    if (stopped)
+        return true;
+    if (sharedStop && sharedStop->load(std::memory_order_relaxed))
+    {
+        stopped = true;
+        return true;
+    }
+
+    // Always finish the first iteration so there is a move to report
+    if (rootDepth <= 1)
+        return false;
+
+    if (limits.nodes && nodes >= limits.nodes)
+        stopped = true;
+    else if (limits.timeMs && (nodes & 1023) == 0 && elapsedMs() >= limits.timeMs)
+        stopped = true;
+
+    return stopped;
+}
+
+int64_t Search::elapsedMs() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - startTime)
+        .count();
+}
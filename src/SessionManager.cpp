@@ -0,0 +1,187 @@
+#include "SessionManager.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include "SessionSlab.h"
+#include <algorithm>
+#include <iterator>
+
+void Session::play(const Move &move)
+{
+    MoveRecord record;
+    record.move = move;
+    Notation::writeSan(board, move, record.san);
+    history.push_back(record);
+    board.makeMove(move);
+}
+
+PackedGame Session::pack() const
+{
+    PackedGame packed;
+    packed.start = start.pack();
+    packed.moves.reserve(history.size());
+
+    Board replay = start;
+    for (const MoveRecord &record : history)
+    {
+        MoveList legal;
+        MoveGen::generate(GenType::LEGAL, replay, replay.getSideToMove(), legal);
+        int index = (int)(std::find(legal.begin(), legal.end(), record.move) - legal.begin());
+        packed.moves.push_back((char)index);
+        replay.makeMove(record.move);
+    }
+    return packed;
+}
+
+std::unique_ptr<Session> Session::unpack(const PackedGame &packed)
+{
+    Board startPosition;
+    startPosition.unpack(packed.start);
+
+    std::unique_ptr<Session> session(new Session(startPosition));
+    session->history.reserve(packed.moves.size());
+    for (char byte : packed.moves)
+    {
+        MoveList legal;
+        MoveGen::generate(GenType::LEGAL, session->board, session->board.getSideToMove(), legal);
+        int index = (uint8_t)byte;
+        if (index >= legal.size())
+            return nullptr;
+        session->play(legal[index]);
+    }
+    return session;
+}
+
+SessionManager::SessionManager(int idleSeconds)
+    : slab(nullptr), memoryLimit(SIZE_MAX), nextId(1), idleLimit(std::chrono::seconds(std::max(0, idleSeconds)))
+{
+}
+
+void SessionManager::attachSlab(SessionSlab *diskTier, size_t memoryGames)
+{
+    slab = diskTier;
+    memoryLimit = memoryGames;
+    if (slab)
+    {
+        nextId = std::max(nextId, slab->getMaxId() + 1);
+        spillColdest();
+    }
+}
+
+uint32_t SessionManager::create(const Board &startPosition)
+{
+    uint32_t id = nextId++;
+    active[id] = ActiveSession{std::unique_ptr<Session>(new Session(startPosition)), Clock::now()};
+    return id;
+}
+
+Session *SessionManager::find(uint32_t id)
+{
+    auto it = active.find(id);
+    if (it != active.end())
+    {
+        it->second.lastUsed = Clock::now();
+        return it->second.session.get();
+    }
+
+    std::unique_ptr<Session> session;
+    auto sleeping = hibernated.find(id);
+    if (sleeping != hibernated.end())
+    {
+        session = Session::unpack(sleeping->second.game);
+        if (!session)
+            return nullptr;
+        coldOrder.erase(sleeping->second.recency);
+        hibernated.erase(sleeping);
+    }
+    else
+    {
+        PackedGame packed;
+        if (!slab || !slab->load(id, packed))
+            return nullptr;
+        session = Session::unpack(packed);
+        if (!session)
+            return nullptr;
+        slab->erase(id);
+    }
+
+    Session *result = session.get();
+    active[id] = ActiveSession{std::move(session), Clock::now()};
+    return result;
+}
+
+bool SessionManager::close(uint32_t id)
+{
+    bool found = active.erase(id) > 0;
+
+    auto sleeping = hibernated.find(id);
+    if (sleeping != hibernated.end())
+    {
+        coldOrder.erase(sleeping->second.recency);
+        hibernated.erase(sleeping);
+        found = true;
+    }
+
+    if (slab && slab->erase(id))
+        found = true;
+    return found;
+}
+
+size_t SessionManager::hibernateIdle()
+{
+    Clock::time_point cutoff = Clock::now() - idleLimit;
+    std::vector<std::pair<Clock::time_point, uint32_t>> idle;
+    for (const auto &entry : active)
+    {
+        if (entry.second.lastUsed <= cutoff)
+            idle.emplace_back(entry.second.lastUsed, entry.first);
+    }
+
+    // Oldest first, so coldOrder stays ordered by last use
+    std::sort(idle.begin(), idle.end());
+    for (const auto &entry : idle)
+    {
+        auto it = active.find(entry.second);
+        coldOrder.push_back(entry.second);
+        hibernated[entry.second] = HibernatedGame{it->second.session->pack(), std::prev(coldOrder.end())};
+        active.erase(it);
+    }
+
+    spillColdest();
+    return idle.size();
+}
+
+size_t SessionManager::spillAll()
+{
+    if (!slab)
+        return active.size() + hibernated.size();
+
+    Clock::duration limit = idleLimit;
+    size_t memoryGames = memoryLimit;
+    idleLimit = Clock::duration::zero();
+    memoryLimit = 0;
+    hibernateIdle();
+    idleLimit = limit;
+    memoryLimit = memoryGames;
+    return hibernated.size();
+}
+
+size_t SessionManager::getSpilledCount() const
+{
+    return slab ? slab->getCount() : 0;
+}
+
+void SessionManager::spillColdest()
+{
+    if (!slab)
+        return;
+
+    while (hibernated.size() > memoryLimit)
+    {
+        uint32_t id = coldOrder.front();
+        auto it = hibernated.find(id);
+        if (!slab->store(id, it->second.game))
+            break;
+        hibernated.erase(it);
+        coldOrder.pop_front();
+    }
+}
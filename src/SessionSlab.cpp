@@ -0,0 +1,335 @@
+#include "SessionSlab.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    const char MAGIC[8] = {'C', 'H', 'S', 'L', 'A', 'B', 0, 0};
+    const uint32_t VERSION = 1;
+    const uint32_t TOMBSTONE = UINT32_MAX;
+    const uint32_t NO_SLOT = UINT32_MAX;
+    const uint32_t MIN_GROWTH = 1024;
+}
+
+struct SessionSlab::Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t indexSize;   ///< Index entries, a power of two
+    uint32_t slotCount;   ///< Slots in the file
+    uint32_t freeHead;    ///< First free slot + 1, or 0 when the free list is empty
+    uint32_t count;       ///< Stored games
+    uint32_t maxId;       ///< Largest id ever stored
+    uint32_t tombstones;  ///< Index entries of erased games
+    uint8_t reserved[28];
+};
+
+struct SessionSlab::IndexEntry
+{
+    uint32_t id;          ///< Session id; 0 for never used, TOMBSTONE for erased
+    uint32_t slot;        ///< First slot of the game
+};
+
+struct SessionSlab::Slot
+{
+    static const size_t PAYLOAD = 118;
+
+    uint32_t id;          ///< Session owning the slot, 0 when free
+    uint32_t next;        ///< Next slot of the game + 1, or next free slot + 1; 0 ends the chain
+    uint16_t length;      ///< Payload bytes used
+    uint8_t payload[PAYLOAD];
+};
+
+SessionSlab::SessionSlab(const std::string &path, uint32_t capacity) : fd(-1), mapping(nullptr), mappedBytes(0)
+{
+    static_assert(sizeof(Header) == 64, "slab header layout is part of the file format");
+    static_assert(sizeof(Slot) == 128, "slab slot layout is part of the file format");
+
+    fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        throw std::runtime_error("cannot open slab file " + path);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("cannot read slab file " + path);
+    }
+
+    bool created = info.st_size == 0;
+    uint32_t indexSize = 1;
+    while (indexSize < 2 * (uint64_t)std::max(1u, capacity) && indexSize < (1u << 31))
+        indexSize *= 2;
+
+    size_t bytes = created ? sizeof(Header) + indexSize * sizeof(IndexEntry) : (size_t)info.st_size;
+    if (bytes < sizeof(Header))
+    {
+        close(fd);
+        throw std::runtime_error(path + " is not a session slab");
+    }
+    if (created && ftruncate(fd, (off_t)bytes) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("cannot size slab file " + path);
+    }
+
+    mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        close(fd);
+        throw std::runtime_error("cannot map slab file " + path);
+    }
+    mappedBytes = bytes;
+
+    Header *h = header();
+    if (created)
+    {
+        // The new file is zero-filled, so the index starts empty
+        std::memcpy(h->magic, MAGIC, sizeof(MAGIC));
+        h->version = VERSION;
+        h->indexSize = indexSize;
+    }
+    else if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0 || h->version != VERSION ||
+             bytes != sizeof(Header) + (size_t)h->indexSize * sizeof(IndexEntry) + (size_t)h->slotCount * sizeof(Slot))
+    {
+        munmap(mapping, mappedBytes);
+        close(fd);
+        throw std::runtime_error(path + " is not a session slab");
+    }
+}
+
+SessionSlab::~SessionSlab()
+{
+    munmap(mapping, mappedBytes);
+    close(fd);
+}
+
+SessionSlab::Header *SessionSlab::header() const
+{
+    return static_cast<Header *>(mapping);
+}
+
+SessionSlab::IndexEntry *SessionSlab::index() const
+{
+    return reinterpret_cast<IndexEntry *>(static_cast<char *>(mapping) + sizeof(Header));
+}
+
+SessionSlab::Slot *SessionSlab::slot(uint32_t number) const
+{
+    char *slots = static_cast<char *>(mapping) + sizeof(Header) + (size_t)header()->indexSize * sizeof(IndexEntry);
+    return reinterpret_cast<Slot *>(slots) + number;
+}
+
+SessionSlab::IndexEntry *SessionSlab::findEntry(uint32_t id, bool insert) const
+{
+    uint32_t mask = header()->indexSize - 1;
+    IndexEntry *entries = index();
+    IndexEntry *reusable = nullptr;
+
+    // Linear probing from a multiplicative hash of the id
+    uint32_t i = (uint32_t)((id * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    for (uint32_t probes = 0; probes <= mask; probes++, i = (i + 1) & mask)
+    {
+        IndexEntry &entry = entries[i];
+        if (entry.id == id)
+            return &entry;
+        if (entry.id == TOMBSTONE && !reusable)
+            reusable = &entry;
+        if (entry.id == 0)
+            return insert ? (reusable ? reusable : &entry) : nullptr;
+    }
+    return insert ? reusable : nullptr;
+}
+
+bool SessionSlab::remap(size_t bytes)
+{
+    if (ftruncate(fd, (off_t)bytes) != 0)
+        return false;
+    void *moved = mremap(mapping, mappedBytes, bytes, MREMAP_MAYMOVE);
+    if (moved == MAP_FAILED)
+        return false;
+    mapping = moved;
+    mappedBytes = bytes;
+    return true;
+}
+
+bool SessionSlab::rehash(uint32_t indexSize)
+{
+    uint32_t oldSize = header()->indexSize;
+    std::vector<IndexEntry> live;
+    live.reserve(header()->count);
+    for (uint32_t i = 0; i < oldSize; i++)
+        if (index()[i].id != 0 && index()[i].id != TOMBSTONE)
+            live.push_back(index()[i]);
+
+    if (indexSize > oldSize)
+    {
+        // Slot numbers are relative to the end of the index, so the slots move up with it
+        size_t slotBytes = (size_t)header()->slotCount * sizeof(Slot);
+        size_t added = (size_t)(indexSize - oldSize) * sizeof(IndexEntry);
+        if (!remap(mappedBytes + added))
+            return false;
+        char *slots = reinterpret_cast<char *>(index() + oldSize);
+        std::memmove(slots + added, slots, slotBytes);
+        header()->indexSize = indexSize;
+    }
+
+    std::memset(index(), 0, (size_t)header()->indexSize * sizeof(IndexEntry));
+    header()->tombstones = 0;
+    for (const IndexEntry &entry : live)
+        *findEntry(entry.id, true) = entry;
+    return true;
+}
+
+uint32_t SessionSlab::allocateSlot()
+{
+    if (!header()->freeHead)
+    {
+        // Grow by half again, and thread the new slots onto the free list
+        uint32_t oldCount = header()->slotCount;
+        uint32_t added = std::max(MIN_GROWTH, oldCount / 2);
+        if (!remap(mappedBytes + (size_t)added * sizeof(Slot)))
+            return NO_SLOT;
+
+        for (uint32_t n = 0; n < added; n++)
+            slot(oldCount + n)->next = (n + 1 < added) ? oldCount + n + 2 : 0;
+        header()->slotCount = oldCount + added;
+        header()->freeHead = oldCount + 1;
+    }
+
+    uint32_t number = header()->freeHead - 1;
+    header()->freeHead = slot(number)->next;
+    slot(number)->next = 0;
+    return number;
+}
+
+void SessionSlab::freeChain(uint32_t first)
+{
+    uint32_t number = first;
+    while (true)
+    {
+        Slot *s = slot(number);
+        uint32_t next = s->next;
+        s->id = 0;
+        s->length = 0;
+        s->next = header()->freeHead;
+        header()->freeHead = number + 1;
+        if (!next)
+            break;
+        number = next - 1;
+    }
+}
+
+bool SessionSlab::store(uint32_t id, const PackedGame &game)
+{
+    if (id == 0 || id == TOMBSTONE)
+        return false;
+
+    // The old copy, if any, stays until the new one is written, so a failure loses nothing.
+    // Keep at least a quarter of the index empty, so probing for a missing id ends early.
+    IndexEntry *entry = findEntry(id, true);
+    bool replacing = entry && entry->id == id;
+    if (!entry || (entry->id == 0 && header()->count + header()->tombstones + 1 > header()->indexSize / 4 * 3))
+    {
+        uint32_t size = header()->indexSize;
+        if (header()->count + 1 > size / 2)
+            size *= 2;
+        if (size == 0 || !rehash(size))
+            return false;
+    }
+
+    // Serialize, then take every slot first: growing the file may move the mapping
+    std::string bytes(reinterpret_cast<const char *>(&game.start), sizeof(PackedPosition));
+    bytes += game.moves;
+    size_t needed = (bytes.size() + Slot::PAYLOAD - 1) / Slot::PAYLOAD;
+    std::vector<uint32_t> chain;
+    for (size_t n = 0; n < needed; n++)
+    {
+        uint32_t number = allocateSlot();
+        if (number == NO_SLOT)
+        {
+            // Each taken slot is a chain of its own until linked below
+            for (uint32_t taken : chain)
+                freeChain(taken);
+            return false;
+        }
+        chain.push_back(number);
+    }
+
+    for (size_t n = 0; n < chain.size(); n++)
+    {
+        Slot *s = slot(chain[n]);
+        size_t offset = n * Slot::PAYLOAD;
+        size_t length = std::min(Slot::PAYLOAD, bytes.size() - offset);
+        s->id = id;
+        s->next = (n + 1 < chain.size()) ? chain[n + 1] + 1 : 0;
+        s->length = (uint16_t)length;
+        std::memcpy(s->payload, bytes.data() + offset, length);
+    }
+
+    entry = findEntry(id, true);
+    if (replacing)
+    {
+        uint32_t old = entry->slot;
+        entry->slot = chain[0];
+        freeChain(old);
+        return true;
+    }
+
+    if (entry->id == TOMBSTONE)
+        header()->tombstones--;
+    entry->id = id;
+    entry->slot = chain[0];
+    header()->count++;
+    header()->maxId = std::max(header()->maxId, id);
+    return true;
+}
+
+bool SessionSlab::load(uint32_t id, PackedGame &game) const
+{
+    const IndexEntry *entry = findEntry(id, false);
+    if (!entry)
+        return false;
+
+    std::string bytes;
+    for (uint32_t number = entry->slot + 1; number; number = slot(number - 1)->next)
+    {
+        const Slot *s = slot(number - 1);
+        bytes.append(reinterpret_cast<const char *>(s->payload), s->length);
+    }
+    if (bytes.size() < sizeof(PackedPosition))
+        return false;
+
+    std::memcpy(&game.start, bytes.data(), sizeof(PackedPosition));
+    game.moves.assign(bytes, sizeof(PackedPosition), std::string::npos);
+    return true;
+}
+
+bool SessionSlab::erase(uint32_t id)
+{
+    IndexEntry *entry = findEntry(id, false);
+    if (!entry)
+        return false;
+
+    freeChain(entry->slot);
+    entry->id = TOMBSTONE;
+    header()->count--;
+    header()->tombstones++;
+    return true;
+}
+
+size_t SessionSlab::getCount() const
+{
+    return header()->count;
+}
+
+uint32_t SessionSlab::getMaxId() const
+{
+    return header()->maxId;
+}
@@ -0,0 +1,101 @@
+#include "SmpSearch.h"
+#include "Numa.h"
+#include <algorithm>
+#include <thread>
+
+SmpSearch::SmpSearch(unsigned threads, size_t hashMb, NumaPolicy policy) : policy(policy), stopped(false)
+{
+    threads = std::max(1u, threads);
+    for (unsigned i = 0; i < threads; i++)
+        threadNodes.push_back(Numa::nodeForThread(i, threads));
+
+    if (policy == NumaPolicy::REPLICATE && Numa::isMultiNode())
+    {
+        for (size_t node = 0; node < Numa::nodes().size(); node++)
+            tables.emplace_back(new TranspositionTable(hashMb, TranspositionTable::Placement::NODE, (int)node));
+    }
+    else
+    {
+        auto placement = (policy == NumaPolicy::INTERLEAVE) ? TranspositionTable::Placement::INTERLEAVED
+                                                            : TranspositionTable::Placement::DEFAULT;
+        tables.emplace_back(new TranspositionTable(hashMb, placement));
+    }
+
+    auto create = [this](unsigned i)
+    {
+        searches[i].reset(new Search());
+        searches[i]->setTable(tables[std::min<size_t>(threadNodes[i], tables.size() - 1)].get());
+        searches[i]->setSharedStop(&stopped);
+    };
+    searches.resize(threads);
+    forEachThread(create);
+}
+
+SearchInfo SmpSearch::run(const Board &board, const SearchLimits &limits,
+                          const std::function<void(const SearchInfo &)> &onIteration)
+{
+    stopped = false;
+    for (auto &table : tables)
+        table->newSearch();
+
+    SearchLimits threadLimits = limits;
+    if (threadLimits.nodes)
+        threadLimits.nodes = std::max<uint64_t>(1, threadLimits.nodes / searches.size());
+
+    SearchInfo result;
+    auto search = [&](unsigned i)
+    {
+        Board own = board;
+        if (i == 0)
+        {
+            result = searches[0]->run(own, threadLimits, onIteration);
+            // The helpers only exist to fill the table for the first thread
+            stopped = true;
+        }
+        else
+        {
+            searches[i]->run(own, threadLimits);
+        }
+    };
+    forEachThread(search);
+    return result;
+}
+
+void SmpSearch::clearTables()
+{
+    for (auto &table : tables)
+        table->clear();
+}
+
+uint64_t SmpSearch::getNodes() const
+{
+    uint64_t total = 0;
+    for (const auto &search : searches)
+        total += search->getNodes();
+    return total;
+}
+
+uint64_t SmpSearch::getReusedNodes() const
+{
+    uint64_t total = 0;
+    for (const auto &search : searches)
+        total += search->getReusedNodes();
+    return total;
+}
+
+void SmpSearch::forEachThread(const std::function<void(unsigned)> &function)
+{
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < searches.size(); i++)
+    {
+        auto worker = [this, &function, i]()
+        {
+            if (policy != NumaPolicy::OFF)
+                Numa::pinThread(threadNodes[i]);
+            function(i);
+        };
+        pool.emplace_back(worker);
+    }
+    for (std::thread &thread : pool)
+        thread.join();
+}
@@ -1,134 +1,95 @@
 #include "SpecialMoves.h"
 
-bool SpecialMoves::canCastleKingSide(Color color, Board &board)
+namespace
 {
-    int row = (color == Color::WHITE) ? 7 : 0;
-
-    // Check if king and rook haven't moved
-    Piece *king = board.getPiece(row, 4);
-    Piece *rook = board.getPiece(row, 7);
-
-    if (!king || !rook)
-        return false;
-    if (king->hasMovedBefore() || rook->hasMovedBefore())
-        return false;
-    if (!king->template isType<King>() || !rook->template isType<Rook>())
-        return false;
-
-    // Check if squares between are empty
-    if (!board.isEmpty(row, 5) || !board.isEmpty(row, 6))
-        return false;
-
-    // Check if king is in check or passes through check
-    Color enemyColor = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
-    if (board.isUnderAttack(Position(row, 4), enemyColor))
-        return false;
-    if (board.isUnderAttack(Position(row, 5), enemyColor))
-        return false;
-    if (board.isUnderAttack(Position(row, 6), enemyColor))
-        return false;
+    bool canCastle(Color color, bool kingSide, Board &board)
+    {
+        int row = (color == Color::WHITE) ? 7 : 0;
+        Square king = makeSquare(row, 4);
+        Square rook = makeSquare(row, kingSide ? 7 : 0);
+        Square target = makeSquare(row, kingSide ? 6 : 2);
+
+        // Check if king and rook haven't moved
+        if (!board.hasCastlingRight(color, kingSide))
+            return false;
+
+        // Check if squares between are empty
+        if (betweenMask(king, rook) & board.getOccupied())
+            return false;
+
+        // Check if king is in check or passes through check
+        Color enemyColor = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+        Bitboard path = betweenMask(king, target) | (1ULL << king) | (1ULL << target);
+        while (path)
+        {
+            if (board.isUnderAttack(Position::fromSquare((Square)popLowest(path)), enemyColor))
+                return false;
+        }
+
+        return true;
+    }
+}
 
-    return true;
+bool SpecialMoves::canCastleKingSide(Color color, Board &board)
+{
+    return canCastle(color, true, board);
 }
 
 bool SpecialMoves::canCastleQueenSide(Color color, Board &board)
 {
-    int row = (color == Color::WHITE) ? 7 : 0;
-
-    // Check if king and rook haven't moved
-    Piece *king = board.getPiece(row, 4);
-    Piece *rook = board.getPiece(row, 0);
-
-    if (!king || !rook)
-        return false;
-    if (king->hasMovedBefore() || rook->hasMovedBefore())
-        return false;
-    if (!king->template isType<King>() || !rook->template isType<Rook>())
-        return false;
-
-    // Check if squares between are empty
-    if (!board.isEmpty(row, 1) || !board.isEmpty(row, 2) || !board.isEmpty(row, 3))
-        return false;
-
-    // Check if king is in check or passes through check
-    Color enemyColor = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
-    if (board.isUnderAttack(Position(row, 4), enemyColor))
-        return false;
-    if (board.isUnderAttack(Position(row, 3), enemyColor))
-        return false;
-    if (board.isUnderAttack(Position(row, 2), enemyColor))
-        return false;
-
-    return true;
+    return canCastle(color, false, board);
 }
 
 void SpecialMoves::performCastling(Color color, bool kingSide, Board &board)
 {
     int row = (color == Color::WHITE) ? 7 : 0;
+    Square king = makeSquare(row, 4);
 
+    // Move king two squares towards the rook, then the rook to the square it crossed
     if (kingSide)
     {
-        // Move king
-        auto king = board.removePiece(Position(row, 4));
-        king->setPosition(Position(row, 6));
-        board.setPiece(Position(row, 6), std::move(king));
-
-        // Move rook
-        auto rook = board.removePiece(Position(row, 7));
-        rook->setPosition(Position(row, 5));
-        board.setPiece(Position(row, 5), std::move(rook));
+        board.movePiece(Position::fromSquare(king), Position::fromSquare(king + 2));
+        board.movePiece(Position::fromSquare(king + 3), Position::fromSquare(king + 1));
     }
     else
     {
-        // Move king
-        auto king = board.removePiece(Position(row, 4));
-        king->setPosition(Position(row, 2));
-        board.setPiece(Position(row, 2), std::move(king));
-
-        // Move rook
-        auto rook = board.removePiece(Position(row, 0));
-        rook->setPosition(Position(row, 3));
-        board.setPiece(Position(row, 3), std::move(rook));
+        board.movePiece(Position::fromSquare(king), Position::fromSquare(king - 2));
+        board.movePiece(Position::fromSquare(king - 4), Position::fromSquare(king - 1));
     }
 }
 
 void SpecialMoves::promotePawn(const Position &pos, char choice, Board &board)
 {
-    Piece *piece = board.getPiece(pos);
-    if (!piece || !piece->template isType<Pawn>())
+    const Piece *piece = board.getPiece(pos);
+    if (!piece || piece->getType() != PieceType::PAWN)
         return;
 
     Color color = piece->getColor();
-    auto promoted = board.removePiece(pos);
 
     switch (choice)
     {
-    case 'Q':
-    case 'q':
-        board.setPiece(pos, std::make_unique<Queen>(color, pos));
-        break;
     case 'R':
     case 'r':
-        board.setPiece(pos, std::make_unique<Rook>(color, pos));
+        board.setPiece(pos, Piece::get('R', color));
         break;
     case 'B':
     case 'b':
-        board.setPiece(pos, std::make_unique<Bishop>(color, pos));
+        board.setPiece(pos, Piece::get('B', color));
         break;
     case 'N':
     case 'n':
-        board.setPiece(pos, std::make_unique<Knight>(color, pos));
+        board.setPiece(pos, Piece::get('N', color));
         break;
     default:
-        board.setPiece(pos, std::make_unique<Queen>(color, pos));
+        board.setPiece(pos, Piece::get('Q', color));
         break;
     }
 }
 
 bool SpecialMoves::isEnPassantMove(const Position &from, const Position &to, Board &board)
 {
-    Piece *piece = board.getPiece(from);
-    if (!piece || !piece->template isType<Pawn>())
+    const Piece *piece = board.getPiece(from);
+    if (!piece || piece->getType() != PieceType::PAWN)
         return false;
 
     if (!board.isEnPassantAvailable())
@@ -141,14 +102,9 @@ bool SpecialMoves::isEnPassantMove(const Position &from, const Position &to, Boa
 
 void SpecialMoves::performEnPassant(const Position &from, const Position &to, Board &board)
 {
-    auto pawn = board.removePiece(from);
-    Color color = pawn->getColor();
-
-    // Remove the captured pawn
-    int capturedRow = (color == Color::WHITE) ? to.getRow() + 1 : to.getRow() - 1;
-    board.removePiece(Position(capturedRow, to.getCol()));
+    // Remove the captured pawn, which stands beside the moving pawn
+    board.removePiece(Position(from.getRow(), to.getCol()));
 
     // Move the pawn
-    pawn->setPosition(to);
-    board.setPiece(to, std::move(pawn));
-}
\ No newline at end of file
+    board.movePiece(from, to);
+}
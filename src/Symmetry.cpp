@@ -0,0 +1,159 @@
+#include "Symmetry.h"
+#include "Zobrist.h"
+
+BitboardPosition Symmetry::fromBoard(const Board &board)
+{
+    BitboardPosition position;
+
+    for (int i = 0; i < 8; i++)
+    {
+        for (int j = 0; j < 8; j++)
+        {
+            const Piece *piece = board.getPiece(i, j);
+            if (!piece)
+                continue;
+            int color = (piece->getColor() == Color::WHITE) ? 0 : 1;
+            position.pieces[color][(int)piece->getType()] |= squareBit(i, j);
+        }
+    }
+
+    position.sideToMove = board.getSideToMove();
+    if (board.hasCastlingRight(Color::WHITE, true))
+        position.castling |= 1;
+    if (board.hasCastlingRight(Color::WHITE, false))
+        position.castling |= 2;
+    if (board.hasCastlingRight(Color::BLACK, true))
+        position.castling |= 4;
+    if (board.hasCastlingRight(Color::BLACK, false))
+        position.castling |= 8;
+    if (Zobrist::isEnPassantCapturable(board))
+        position.enPassantCol = (int8_t)board.getEnPassantTarget().getCol();
+
+    return position;
+}
+
+std::string Symmetry::toFEN(const BitboardPosition &position)
+{
+    std::string fen;
+    for (int i = 0; i < 8; i++)
+    {
+        int empty = 0;
+        for (int j = 0; j < 8; j++)
+        {
+            char letter = 0;
+            Bitboard bit = squareBit(i, j);
+            for (int c = 0; c < 2 && !letter; c++)
+            {
+                for (int type = 0; type < 6; type++)
+                {
+                    if (position.pieces[c][type] & bit)
+                    {
+                        letter = fenLetter((PieceType)type, (Color)c);
+                        break;
+                    }
+                }
+            }
+
+            if (!letter)
+            {
+                empty++;
+                continue;
+            }
+            if (empty)
+                fen += (char)('0' + empty);
+            empty = 0;
+            fen += letter;
+        }
+        if (empty)
+            fen += (char)('0' + empty);
+        if (i < 7)
+            fen += '/';
+    }
+
+    fen += (position.sideToMove == Color::WHITE) ? " w " : " b ";
+
+    std::string castling;
+    const char rights[] = "KQkq";
+    for (int i = 0; i < 4; i++)
+    {
+        if (position.castling & (1 << i))
+            castling += rights[i];
+    }
+    fen += castling.empty() ? "-" : castling;
+
+    if (position.enPassantCol >= 0)
+    {
+        fen += ' ';
+        fen += (char)('a' + position.enPassantCol);
+        fen += (position.sideToMove == Color::WHITE) ? '6' : '3';
+    }
+    else
+    {
+        fen += " -";
+    }
+
+    return fen + " 0 1";
+}
+
+BitboardPosition Symmetry::mirror(const BitboardPosition &position)
+{
+    BitboardPosition result = position;
+    for (auto &colorBoards : result.pieces)
+    {
+        for (Bitboard &bb : colorBoards)
+            bb = mirrorHorizontal(bb);
+    }
+    if (result.enPassantCol >= 0)
+        result.enPassantCol = (int8_t)(7 - result.enPassantCol);
+    return result;
+}
+
+BitboardPosition Symmetry::swapColors(const BitboardPosition &position)
+{
+    BitboardPosition result = position;
+    for (int type = 0; type < 6; type++)
+    {
+        result.pieces[0][type] = flipVertical(position.pieces[1][type]);
+        result.pieces[1][type] = flipVertical(position.pieces[0][type]);
+    }
+    result.sideToMove = (position.sideToMove == Color::WHITE) ? Color::BLACK : Color::WHITE;
+
+    // White's KQ rights become Black's kq and vice versa
+    result.castling = (uint8_t)(((position.castling & 3) << 2) | ((position.castling >> 2) & 3));
+    return result;
+}
+
+CanonicalForm Symmetry::canonicalize(const Board &board, bool allowColorSwap)
+{
+    CanonicalForm best;
+    BitboardPosition original = fromBoard(board);
+    best.position = original;
+    best.key = Zobrist::hash(original);
+
+    // Castling rights pin the king and rooks to their files, so only castle-free positions mirror
+    bool allowMirror = original.castling == 0;
+
+    for (int swap = 0; swap <= (allowColorSwap ? 1 : 0); swap++)
+    {
+        for (int flip = 0; flip <= (allowMirror ? 1 : 0); flip++)
+        {
+            if (!swap && !flip)
+                continue;
+
+            BitboardPosition candidate = swap ? swapColors(original) : original;
+            if (flip)
+                candidate = mirror(candidate);
+
+            uint64_t key = Zobrist::hash(candidate);
+            if (key < best.key)
+            {
+                best.position = candidate;
+                best.key = key;
+                best.mirrored = flip;
+                best.colorSwapped = swap;
+            }
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,128 @@
+#include "TranspositionTable.h"
+#include "Numa.h"
+#include <memory>
+#include <new>
+#include <sys/mman.h>
+
+namespace
+{
+    const char promotionLetters[] = {0, 'Q', 'R', 'B', 'N'};
+
+    // Move layout: from square (64 = null) in bits 0-6, to square in 7-12, promotion in 13-15
+    uint64_t packMove(const Move &move)
+    {
+        if (move.isNull())
+            return 64;
+
+        uint64_t promotion = 0;
+        for (int i = 1; i < 5; i++)
+        {
+            if (promotionLetters[i] == move.getPromotion())
+                promotion = (uint64_t)i;
+        }
+        return move.getFrom().getSquare() | ((uint64_t)move.getTo().getSquare() << 7) | (promotion << 13);
+    }
+
+    Move unpackMove(uint64_t bits)
+    {
+        Square from = (Square)(bits & 127);
+        if (from >= NO_SQUARE)
+            return Move();
+        return Move(Position::fromSquare(from), Position::fromSquare((Square)((bits >> 7) & 63)),
+                    promotionLetters[(bits >> 13) & 7]);
+    }
+
+    // Data layout: move in bits 0-15, score in 16-31, depth in 32-39, bound in 40-41, generation in 42-47
+    uint64_t pack(const TTData &data, uint8_t generation)
+    {
+        uint64_t depth = (uint64_t)(data.depth < 0 ? 0 : (data.depth > 255 ? 255 : data.depth));
+        return packMove(data.move) | ((uint64_t)(uint16_t)(int16_t)data.score << 16) | (depth << 32) |
+               ((uint64_t)data.bound << 40) | ((uint64_t)generation << 42);
+    }
+
+    uint8_t generationOf(uint64_t bits)
+    {
+        return (uint8_t)((bits >> 42) & 63);
+    }
+
+    TTData unpack(uint64_t bits)
+    {
+        TTData data;
+        data.move = unpackMove(bits & 0xFFFF);
+        data.score = (int16_t)(uint16_t)(bits >> 16);
+        data.depth = (int)((bits >> 32) & 255);
+        data.bound = (Bound)((bits >> 40) & 3);
+        return data;
+    }
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes, Placement placement, int node) : generation(0)
+{
+    slotCount = 1;
+    while (slotCount * 2 * sizeof(Slot) <= megabytes * 1024 * 1024)
+        slotCount *= 2;
+    bytes = slotCount * sizeof(Slot);
+
+    // Map the table directly so its pages can be placed before anything touches them
+    void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        throw std::bad_alloc();
+
+    if (placement == Placement::NODE)
+        Numa::bindMemory(memory, bytes, node);
+    else if (placement == Placement::INTERLEAVED)
+        Numa::interleaveMemory(memory, bytes);
+
+    slots = static_cast<Slot *>(memory);
+    std::uninitialized_default_construct_n(slots, slotCount);
+    clear();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+    munmap(slots, bytes);
+}
+
+bool TranspositionTable::probe(uint64_t key, TTData &data) const
+{
+    const Slot &slot = slotFor(key);
+    uint64_t bits = slot.data.load(std::memory_order_relaxed);
+    if ((slot.check.load(std::memory_order_relaxed) ^ bits) != key)
+        return false;
+
+    data = unpack(bits);
+    data.carried = generationOf(bits) != generation;
+    return data.bound != Bound::NONE;
+}
+
+void TranspositionTable::store(uint64_t key, const TTData &data)
+{
+    Slot &slot = slotFor(key);
+    uint64_t old = slot.data.load(std::memory_order_relaxed);
+    if (unpack(old).bound != Bound::NONE && generationOf(old) == generation)
+    {
+        TTData stored = unpack(old);
+        if ((slot.check.load(std::memory_order_relaxed) ^ old) == key)
+        {
+            if (data.depth < stored.depth && data.bound != Bound::EXACT)
+                return;
+        }
+        else if (stored.depth > data.depth + REPLACE_MARGIN)
+        {
+            return;
+        }
+    }
+
+    uint64_t bits = pack(data, generation);
+    slot.data.store(bits, std::memory_order_relaxed);
+    slot.check.store(key ^ bits, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i < slotCount; i++)
+    {
+        slots[i].data.store(0, std::memory_order_relaxed);
+        slots[i].check.store(0, std::memory_order_relaxed);
+    }
+}
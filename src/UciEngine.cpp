@@ -0,0 +1,325 @@
+#include "UciEngine.h"
+#include "Notation.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+namespace
+{
+    const size_t DEFAULT_HASH_MB = 16;
+    const size_t MAX_HASH_MB = 65536;
+    const unsigned MAX_THREADS = 256;
+
+    std::string lowercase(std::string text)
+    {
+        for (char &c : text)
+            c = (char)std::tolower((unsigned char)c);
+        return text;
+    }
+
+    // Formats a score as "cp <n>" or, for a forced mate, "mate <moves>"
+    std::string formatScore(int score)
+    {
+        if (!Search::isMateScore(score))
+            return "cp " + std::to_string(score);
+        int plies = Search::MATE_SCORE - std::abs(score);
+        int moves = (plies + 1) / 2;
+        return "mate " + std::to_string(score > 0 ? moves : -moves);
+    }
+
+    std::string formatInfo(const SearchInfo &info)
+    {
+        std::string line = "info depth " + std::to_string(info.depth) +
+                           " score " + formatScore(info.score) +
+                           " nodes " + std::to_string(info.nodes) +
+                           " nps " + std::to_string(info.nodes * 1000 / (uint64_t)std::max<int64_t>(1, info.timeMs)) +
+                           " time " + std::to_string(info.timeMs) + " pv";
+        for (const Move &move : info.pv)
+            line += " " + move.toUci();
+        return line;
+    }
+}
+
+UciEngine::UciEngine(std::ostream &output)
+    : out(output), threads(1), hashMb(DEFAULT_HASH_MB), halt(false), finished(true), waitForStop(false),
+      pondering(false), budgetMs(0)
+{
+    board.initialize();
+    search.reset(new SmpSearch(threads, hashMb, NumaPolicy::OFF));
+}
+
+UciEngine::~UciEngine()
+{
+    stopSearch();
+}
+
+void UciEngine::run(std::istream &input)
+{
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (!execute(line))
+            break;
+    }
+    stopSearch();
+}
+
+bool UciEngine::execute(const std::string &line)
+{
+    std::istringstream args(line);
+    std::string command;
+    args >> command;
+
+    if (command == "uci")
+    {
+        send("id name Chess-Game");
+        send("id author Chess-Game contributors");
+        send("option name Hash type spin default " + std::to_string(DEFAULT_HASH_MB) +
+             " min 1 max " + std::to_string(MAX_HASH_MB));
+        send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+        send("option name Ponder type check default false");
+        send("uciok");
+    }
+    else if (command == "isready")
+    {
+        send("readyok");
+    }
+    else if (command == "ucinewgame")
+    {
+        stopSearch();
+        search->clearTables();
+    }
+    else if (command == "position")
+    {
+        stopSearch();
+        position(args);
+    }
+    else if (command == "go")
+    {
+        stopSearch();
+        go(args);
+    }
+    else if (command == "stop")
+    {
+        stopSearch();
+    }
+    else if (command == "ponderhit")
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (pondering)
+        {
+            pondering = false;
+            deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMs);
+            waitForStop = false;
+            stateChanged.notify_all();
+        }
+    }
+    else if (command == "setoption")
+    {
+        stopSearch();
+        setOption(args);
+    }
+    else if (command == "quit")
+    {
+        stopSearch();
+        return false;
+    }
+    else if (!command.empty())
+    {
+        send("info string unknown command " + command);
+    }
+    return true;
+}
+
+void UciEngine::position(std::istream &args)
+{
+    std::string token;
+    args >> token;
+
+    Board next;
+    if (token == "startpos")
+    {
+        next.initialize();
+        args >> token;
+    }
+    else if (token == "fen")
+    {
+        std::string fen;
+        while (args >> token && token != "moves")
+            fen += (fen.empty() ? "" : " ") + token;
+        if (!next.loadFEN(fen))
+        {
+            send("info string bad FEN " + fen);
+            return;
+        }
+    }
+    else
+    {
+        send("info string expected startpos or fen");
+        return;
+    }
+
+    // Replay into the temporary board and take it only if every move is legal
+    if (token == "moves")
+    {
+        while (args >> token)
+        {
+            Move move = Notation::fromUci(next, token);
+            if (move.isNull())
+            {
+                send("info string illegal move " + token + ", position unchanged");
+                return;
+            }
+            next.makeMove(move);
+        }
+    }
+    board = next;
+}
+
+void UciEngine::go(std::istream &args)
+{
+    SearchLimits limits;
+    int64_t moveTime = 0, time[2] = {0, 0}, increment[2] = {0, 0}, movesToGo = 0;
+    bool infinite = false, ponder = false;
+
+    std::string token;
+    while (args >> token)
+    {
+        if (token == "depth")
+            args >> limits.depth;
+        else if (token == "nodes")
+            args >> limits.nodes;
+        else if (token == "movetime")
+            args >> moveTime;
+        else if (token == "wtime")
+            args >> time[0];
+        else if (token == "btime")
+            args >> time[1];
+        else if (token == "winc")
+            args >> increment[0];
+        else if (token == "binc")
+            args >> increment[1];
+        else if (token == "movestogo")
+            args >> movesToGo;
+        else if (token == "infinite")
+            infinite = true;
+        else if (token == "ponder")
+            ponder = true;
+    }
+
+    // Spend an even share of the remaining time plus most of the increment,
+    // keeping a margin for the GUI's own overhead
+    int us = board.getSideToMove() == Color::WHITE ? 0 : 1;
+    int64_t budget = moveTime;
+    if (!budget && time[us] > 0)
+    {
+        budget = time[us] / (movesToGo > 0 ? movesToGo : 30) + increment[us] * 3 / 4;
+        budget = std::max<int64_t>(1, std::min(budget, time[us] - std::min<int64_t>(time[us] / 2, 50)));
+    }
+    if (infinite)
+        budget = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        halt = false;
+        finished = false;
+        waitForStop = infinite || ponder;
+        pondering = ponder;
+        budgetMs = budget;
+        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budget);
+    }
+
+    // Time is left to the timer so a ponder search can start its clock on ponderhit
+    limits.timeMs = 0;
+    worker = std::thread(&UciEngine::searchLoop, this, board, limits);
+    timer = std::thread(&UciEngine::timerLoop, this);
+}
+
+void UciEngine::setOption(std::istream &args)
+{
+    std::string token, name, value;
+    args >> token;
+    while (args >> token && token != "value")
+        name += (name.empty() ? "" : " ") + token;
+    std::getline(args >> std::ws, value);
+
+    name = lowercase(name);
+    if (name == "hash" || name == "threads")
+    {
+        long number = std::atol(value.c_str());
+        if (name == "hash")
+            hashMb = (size_t)std::max(1L, std::min<long>(number, (long)MAX_HASH_MB));
+        else
+            threads = (unsigned)std::max(1L, std::min<long>(number, (long)MAX_THREADS));
+        search.reset();
+        search.reset(new SmpSearch(threads, hashMb, NumaPolicy::OFF));
+    }
+    else if (name != "ponder")
+    {
+        send("info string unknown option " + name);
+    }
+}
+
+void UciEngine::stopSearch()
+{
+    if (!worker.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        halt = true;
+        stateChanged.notify_all();
+    }
+    search->stop();
+    worker.join();
+    timer.join();
+}
+
+void UciEngine::searchLoop(Board root, SearchLimits limits)
+{
+    // A stop that arrives before the search has reset its flag is caught here,
+    // after the first iteration, which takes microseconds
+    auto report = [this](const SearchInfo &info)
+    {
+        send(formatInfo(info));
+        if (halt)
+            search->stop();
+    };
+    SearchInfo result = search->run(root, limits, report);
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    finished = true;
+    stateChanged.notify_all();
+
+    // UCI forbids sending the best move of an infinite or ponder search before it is asked for
+    auto released = [this]() { return !waitForStop || halt; };
+    stateChanged.wait(lock, released);
+    lock.unlock();
+
+    std::string line = "bestmove " + (result.pv.empty() ? std::string("0000") : result.pv[0].toUci());
+    if (result.pv.size() > 1)
+        line += " ponder " + result.pv[1].toUci();
+    send(line);
+}
+
+void UciEngine::timerLoop()
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    while (!finished && !halt)
+    {
+        if (pondering || !budgetMs)
+            stateChanged.wait(lock);
+        else if (stateChanged.wait_until(lock, deadline) == std::cv_status::timeout)
+        {
+            halt = true;
+            search->stop();
+        }
+    }
+}
+
+void UciEngine::send(const std::string &line)
+{
+    std::lock_guard<std::mutex> lock(outputMutex);
+    out << line << std::endl;
+}
@@ -0,0 +1,105 @@
+#include "Zobrist.h"
+
+uint64_t Zobrist::pieceKey(char letter, Color color, int row, int col)
+{
+    int index = pieceTypeIndex(letter) + ((color == Color::WHITE) ? 0 : 6);
+    return ZOBRIST_KEYS.pieces[index][row * 8 + col];
+}
+
+uint64_t Zobrist::sideKey()
+{
+    return ZOBRIST_KEYS.side;
+}
+
+uint64_t Zobrist::castlingKey(int index)
+{
+    return ZOBRIST_KEYS.castling[index];
+}
+
+uint64_t Zobrist::enPassantKey(int col)
+{
+    return ZOBRIST_KEYS.enPassant[col];
+}
+
+bool Zobrist::isEnPassantCapturable(const Board &board)
+{
+    if (!board.isEnPassantAvailable())
+        return false;
+
+    Position target = board.getEnPassantTarget();
+    Color us = board.getSideToMove();
+    int pawnRow = target.getRow() + ((us == Color::WHITE) ? 1 : -1);
+
+    for (int col = target.getCol() - 1; col <= target.getCol() + 1; col += 2)
+    {
+        const Piece *piece = board.getPiece(pawnRow, col);
+        if (piece && piece->getColor() == us && piece->getType() == PieceType::PAWN)
+            return true;
+    }
+    return false;
+}
+
+uint64_t Zobrist::hash(const Board &board)
+{
+    uint64_t key = 0;
+
+    // Visit only the occupied squares
+    for (int c = 0; c < 2; c++)
+    {
+        for (int type = 0; type < PIECE_TYPE_COUNT; type++)
+        {
+            Bitboard bb = board.getPieces((Color)c, (PieceType)type);
+            while (bb)
+                key ^= ZOBRIST_KEYS.pieces[type + 6 * c][popLowest(bb)];
+        }
+    }
+
+    if (board.getSideToMove() == Color::BLACK)
+        key ^= sideKey();
+
+    if (board.hasCastlingRight(Color::WHITE, true))
+        key ^= castlingKey(0);
+    if (board.hasCastlingRight(Color::WHITE, false))
+        key ^= castlingKey(1);
+    if (board.hasCastlingRight(Color::BLACK, true))
+        key ^= castlingKey(2);
+    if (board.hasCastlingRight(Color::BLACK, false))
+        key ^= castlingKey(3);
+
+    // Only a capturable en passant square changes which moves are legal
+    if (isEnPassantCapturable(board))
+        key ^= enPassantKey(board.getEnPassantTarget().getCol());
+
+    return key;
+}
+
+uint64_t Zobrist::hash(const BitboardPosition &position)
+{
+    uint64_t key = 0;
+
+    for (int c = 0; c < 2; c++)
+    {
+        Color color = (c == 0) ? Color::WHITE : Color::BLACK;
+        for (int type = 0; type < 6; type++)
+        {
+            Bitboard bb = position.pieces[c][type];
+            while (bb)
+            {
+                int square = popLowest(bb);
+                key ^= pieceKey(PIECE_LETTERS[type], color, square / 8, square % 8);
+            }
+        }
+    }
+
+    if (position.sideToMove == Color::BLACK)
+        key ^= sideKey();
+    for (int i = 0; i < 4; i++)
+    {
+        if (position.castling & (1 << i))
+            key ^= castlingKey(i);
+    }
+    if (position.enPassantCol >= 0)
+        key ^= enPassantKey(position.enPassantCol);
+
+    return key;
+}
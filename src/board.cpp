@@ -1,98 +1,322 @@
 #include "Board.h"
-#include <iostream>
-
-Board::Board() : enPassantAvailable(false)
+#include "BoardRenderer.h"
+#include "Attacks.h"
+#include "Zobrist.h"
+#include <sstream>
+#include <cctype>
+#include <cstdlib>
+#include <algorithm>
+#include <type_traits>
+
+namespace
 {
-    for (int i = 0; i < 8; i++)
+    // Piece code layout: (color << 3) | (type + 1), so 0 means an empty square
+    uint8_t pieceCode(PieceType type, Color color)
     {
-        for (int j = 0; j < 8; j++)
+        return (uint8_t)(((int)color << 3) | ((int)type + 1));
+    }
+
+    PieceType codeType(uint8_t code) { return (PieceType)((code & 7) - 1); }
+
+    Color codeColor(uint8_t code) { return (Color)(code >> 3); }
+
+    uint8_t pieceCode(const Piece *piece)
+    {
+        return pieceCode(piece->getType(), piece->getColor());
+    }
+
+    const Piece *codePiece(uint8_t code)
+    {
+        return code ? Piece::get(codeType(code), codeColor(code)) : nullptr;
+    }
+
+    uint64_t pieceKey(Square square, uint8_t code)
+    {
+        return ZOBRIST_KEYS.pieces[(int)codeType(code) + 6 * (code >> 3)][square];
+    }
+
+    // Key component of a set of castling rights
+    uint64_t castlingKey(uint8_t rights)
+    {
+        uint64_t key = 0;
+        for (int bit = 0; bit < 4; bit++)
+            if (rights & (1 << bit))
+                key ^= ZOBRIST_KEYS.castling[bit];
+        return key;
+    }
+
+    // Castling rights that survive a move touching each square
+    struct CastlingMasks
+    {
+        uint8_t mask[64];
+
+        CastlingMasks()
         {
-            squares[i][j] = nullptr;
+            for (uint8_t &m : mask)
+                m = 0xF;
+            mask[0] = (uint8_t)~8;        // a8: q
+            mask[4] = (uint8_t)~(4 | 8);  // e8: k and q
+            mask[7] = (uint8_t)~4;        // h8: k
+            mask[56] = (uint8_t)~2;       // a1: Q
+            mask[60] = (uint8_t)~(1 | 2); // e1: K and Q
+            mask[63] = (uint8_t)~1;       // h1: K
         }
+    };
+
+    const CastlingMasks castlingMasks;
+
+    const PieceType backRank[] = {PieceType::ROOK, PieceType::KNIGHT, PieceType::BISHOP, PieceType::QUEEN,
+                                  PieceType::KING, PieceType::BISHOP, PieceType::KNIGHT, PieceType::ROOK};
+}
+
+static_assert(std::is_trivially_copyable<Board>::value, "Board must stay a plain value");
+static_assert(sizeof(Board) <= 128, "Board should fit in two cache lines");
+
+Board::Board()
+    : byColor(), byType(), mailbox(), sideToMove(Color::WHITE), castlingRights(0), enPassantSquare(NO_SQUARE),
+      halfmoveClock(0), fullmoveNumber(1), key(0)
+{
+}
+
+void Board::put(Square square, uint8_t code)
+{
+    Bitboard bit = 1ULL << square;
+    byColor[code >> 3] |= bit;
+    byType[(int)codeType(code)] |= bit;
+    mailbox[square >> 1] |= (uint8_t)(code << ((square & 1) * 4));
+    key ^= pieceKey(square, code);
+}
+
+uint8_t Board::take(Square square)
+{
+    uint8_t code = codeAt(square);
+    if (code)
+    {
+        Bitboard bit = 1ULL << square;
+        byColor[code >> 3] &= ~bit;
+        byType[(int)codeType(code)] &= ~bit;
+        mailbox[square >> 1] &= (uint8_t)(0xF0 >> ((square & 1) * 4));
+        key ^= pieceKey(square, code);
     }
+    return code;
+}
+
+void Board::setCastlingRights(uint8_t rights)
+{
+    key ^= castlingKey(castlingRights ^ rights);
+    castlingRights = rights;
 }
 
 void Board::initialize()
 {
-    // Place black pieces
-    squares[0][0] = std::make_unique<Rook>(Color::BLACK, Position(0, 0));
-    squares[0][1] = std::make_unique<Knight>(Color::BLACK, Position(0, 1));
-    squares[0][2] = std::make_unique<Bishop>(Color::BLACK, Position(0, 2));
-    squares[0][3] = std::make_unique<Queen>(Color::BLACK, Position(0, 3));
-    squares[0][4] = std::make_unique<King>(Color::BLACK, Position(0, 4));
-    squares[0][5] = std::make_unique<Bishop>(Color::BLACK, Position(0, 5));
-    squares[0][6] = std::make_unique<Knight>(Color::BLACK, Position(0, 6));
-    squares[0][7] = std::make_unique<Rook>(Color::BLACK, Position(0, 7));
+    // Clear any previous game
+    *this = Board();
 
     for (int i = 0; i < 8; i++)
     {
-        squares[1][i] = std::make_unique<Pawn>(Color::BLACK, Position(1, i));
+        // Place black pieces
+        put(i, pieceCode(backRank[i], Color::BLACK));
+        put(8 + i, pieceCode(PieceType::PAWN, Color::BLACK));
+
+        // Place white pieces
+        put(48 + i, pieceCode(PieceType::PAWN, Color::WHITE));
+        put(56 + i, pieceCode(backRank[i], Color::WHITE));
     }
 
-    // Place white pieces
-    for (int i = 0; i < 8; i++)
+    setCastlingRights(0xF);
+}
+
+bool Board::loadFEN(const std::string &fen)
+{
+    std::istringstream in(fen);
+    std::string placement, side, castling = "-", enPassant = "-", halfmove = "0", fullmove = "1";
+    if (!(in >> placement >> side))
+        return false;
+    in >> castling >> enPassant >> halfmove >> fullmove;
+
+    if (side != "w" && side != "b")
+        return false;
+
+    // Parse into a scratch board so a malformed FEN leaves this one untouched
+    Board parsed;
+    int row = 0, col = 0, whiteKings = 0, blackKings = 0;
+    for (char c : placement)
+    {
+        if (c == '/')
+        {
+            if (col != 8)
+                return false;
+            row++;
+            col = 0;
+        }
+        else if (c >= '1' && c <= '8')
+        {
+            col += c - '0';
+            if (col > 8)
+                return false;
+        }
+        else
+        {
+            if (row > 7 || col > 7)
+                return false;
+            Color color = std::isupper((unsigned char)c) ? Color::WHITE : Color::BLACK;
+            int type = pieceTypeIndex((char)std::toupper((unsigned char)c));
+            if (type < 0)
+                return false;
+            parsed.put(row * 8 + col, pieceCode((PieceType)type, color));
+            if (type == (int)PieceType::KING)
+                (color == Color::WHITE ? whiteKings : blackKings)++;
+            col++;
+        }
+    }
+    if (row != 7 || col != 8 || whiteKings != 1 || blackKings != 1)
+        return false;
+
+    // Keep only castling rights whose king and rook are still on their home squares
+    const char rights[] = "KQkq";
+    for (int bit = 0; bit < 4; bit++)
     {
-        squares[6][i] = std::make_unique<Pawn>(Color::WHITE, Position(6, i));
+        if (castling.find(rights[bit]) == std::string::npos)
+            continue;
+
+        Color color = (bit < 2) ? Color::WHITE : Color::BLACK;
+        int homeRow = (bit < 2) ? 7 : 0;
+        int rookCol = (bit % 2 == 0) ? 7 : 0;
+        if (parsed.codeAt(homeRow * 8 + 4) == pieceCode(PieceType::KING, color) &&
+            parsed.codeAt(homeRow * 8 + rookCol) == pieceCode(PieceType::ROOK, color))
+        {
+            parsed.setCastlingRights((uint8_t)(parsed.castlingRights | (1 << bit)));
+        }
     }
 
-    squares[7][0] = std::make_unique<Rook>(Color::WHITE, Position(7, 0));
-    squares[7][1] = std::make_unique<Knight>(Color::WHITE, Position(7, 1));
-    squares[7][2] = std::make_unique<Bishop>(Color::WHITE, Position(7, 2));
-    squares[7][3] = std::make_unique<Queen>(Color::WHITE, Position(7, 3));
-    squares[7][4] = std::make_unique<King>(Color::WHITE, Position(7, 4));
-    squares[7][5] = std::make_unique<Bishop>(Color::WHITE, Position(7, 5));
-    squares[7][6] = std::make_unique<Knight>(Color::WHITE, Position(7, 6));
-    squares[7][7] = std::make_unique<Rook>(Color::WHITE, Position(7, 7));
+    if (enPassant.length() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h' &&
+        enPassant[1] >= '1' && enPassant[1] <= '8')
+    {
+        parsed.setEnPassantTarget(Position(8 - (enPassant[1] - '0'), enPassant[0] - 'a'));
+    }
+
+    parsed.setSideToMove((side == "w") ? Color::WHITE : Color::BLACK);
+    parsed.halfmoveClock = (uint16_t)std::max(0, std::atoi(halfmove.c_str()));
+    parsed.fullmoveNumber = (uint16_t)std::max(1, std::atoi(fullmove.c_str()));
+    *this = parsed;
+    return true;
 }
 
-void Board::display() const
+PackedPosition Board::pack() const
+{
+    PackedPosition packed;
+    std::copy(mailbox, mailbox + 32, packed.mailbox);
+    packed.state = (uint8_t)(castlingRights | (sideToMove == Color::BLACK ? 0x10 : 0));
+    packed.enPassantSquare = enPassantSquare;
+    packed.halfmoveClock = halfmoveClock;
+    packed.fullmoveNumber = fullmoveNumber;
+    return packed;
+}
+
+void Board::unpack(const PackedPosition &packed)
+{
+    *this = Board();
+    for (int square = 0; square < 64; square++)
+    {
+        uint8_t code = (packed.mailbox[square >> 1] >> ((square & 1) * 4)) & 0xF;
+        if (code)
+            put((Square)square, code);
+    }
+    setCastlingRights(packed.state & 0xF);
+    setSideToMove((packed.state & 0x10) ? Color::BLACK : Color::WHITE);
+    enPassantSquare = packed.enPassantSquare;
+    halfmoveClock = packed.halfmoveClock;
+    fullmoveNumber = packed.fullmoveNumber;
+}
+
+std::string Board::toFEN() const
 {
-    std::cout << "\n  +---+---+---+---+---+---+---+---+\n";
+    std::string fen;
     for (int i = 0; i < 8; i++)
     {
-        std::cout << (8 - i) << " |";
+        int empty = 0;
         for (int j = 0; j < 8; j++)
         {
-            if (squares[i][j])
+            const Piece *piece = getPiece(i, j);
+            if (!piece)
             {
-                std::cout << " " << squares[i][j]->getSymbol() << " |";
+                empty++;
+                continue;
             }
-            else
+            if (empty)
             {
-                std::cout << "   |";
+                fen += (char)('0' + empty);
+                empty = 0;
             }
+            fen += fenLetter(piece->getType(), piece->getColor());
         }
-        std::cout << "\n  +---+---+---+---+---+---+---+---+\n";
+        if (empty)
+            fen += (char)('0' + empty);
+        if (i < 7)
+            fen += '/';
     }
-    std::cout << "    a   b   c   d   e   f   g   h\n\n";
+
+    fen += (sideToMove == Color::WHITE) ? " w " : " b ";
+
+    std::string castling;
+    if (hasCastlingRight(Color::WHITE, true))
+        castling += 'K';
+    if (hasCastlingRight(Color::WHITE, false))
+        castling += 'Q';
+    if (hasCastlingRight(Color::BLACK, true))
+        castling += 'k';
+    if (hasCastlingRight(Color::BLACK, false))
+        castling += 'q';
+    fen += castling.empty() ? "-" : castling;
+
+    fen += ' ';
+    if (isEnPassantAvailable())
+    {
+        std::ostringstream ep;
+        ep << getEnPassantTarget();
+        fen += ep.str();
+    }
+    else
+    {
+        fen += '-';
+    }
+
+    fen += " " + std::to_string(halfmoveClock) + " " + std::to_string(fullmoveNumber);
+    return fen;
 }
 
-Piece *Board::getPiece(const Position &pos) const
+void Board::display() const
+{
+    BoardRenderer renderer;
+    renderer.render(*this);
+}
+
+const Piece *Board::getPiece(const Position &pos) const
 {
     if (!pos.isValid())
         return nullptr;
-    return squares[pos.getRow()][pos.getCol()].get();
+    return codePiece(codeAt(pos.getSquare()));
 }
 
-Piece *Board::getPiece(int row, int col) const
+const Piece *Board::getPiece(int row, int col) const
 {
     if (row < 0 || row >= 8 || col < 0 || col >= 8)
         return nullptr;
-    return squares[row][col].get();
+    return codePiece(codeAt(row * 8 + col));
 }
 
 bool Board::isEmpty(const Position &pos) const
 {
     if (!pos.isValid())
         return false;
-    return squares[pos.getRow()][pos.getCol()] == nullptr;
+    return !(getOccupied() & (1ULL << pos.getSquare()));
 }
 
 bool Board::isEmpty(int row, int col) const
 {
     if (row < 0 || row >= 8 || col < 0 || col >= 8)
         return true;
-    return squares[row][col] == nullptr;
+    return !(getOccupied() & squareBit(row, col));
 }
 
 bool Board::movePiece(const Position &from, const Position &to)
@@ -102,22 +326,14 @@ bool Board::movePiece(const Position &from, const Position &to)
     if (isEmpty(from))
         return false;
 
-    // Remove destination piece if any (capture)
-    if (!isEmpty(to))
-    {
-        removePiece(to);
-    }
-
-    // Move the piece
-    std::unique_ptr<Piece> movingPiece = removePiece(from);
-    if (movingPiece)
-    {
-        movingPiece->setPosition(to);
-        setPiece(to, std::move(movingPiece));
-        return true;
-    }
+    // Remove destination piece if any (capture), then move the piece
+    Square fromSquare = from.getSquare(), toSquare = to.getSquare();
+    take(toSquare);
+    put(toSquare, take(fromSquare));
 
-    return false;
+    // A king or rook leaving home, or a rook captured at home, ends those castling rights
+    setCastlingRights(castlingRights & castlingMasks.mask[fromSquare] & castlingMasks.mask[toSquare]);
+    return true;
 }
 
 bool Board::movePiece(int fromRow, int fromCol, int toRow, int toCol)
@@ -125,84 +341,70 @@ bool Board::movePiece(int fromRow, int fromCol, int toRow, int toCol)
     return movePiece(Position(fromRow, fromCol), Position(toRow, toCol));
 }
 
-void Board::setPiece(const Position &pos, std::unique_ptr<Piece> piece)
+void Board::setSideToMove(Color color)
+{
+    if (color != sideToMove)
+        key ^= ZOBRIST_KEYS.side;
+    sideToMove = color;
+}
+
+uint64_t Board::getKey() const
+{
+    // The en passant file counts only while a pawn of the side to move can capture there
+    Color them = (sideToMove == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    if (enPassantSquare != NO_SQUARE && (pawnAttacks(them, enPassantSquare) & getPieces(sideToMove, PieceType::PAWN)))
+        return key ^ ZOBRIST_KEYS.enPassant[colOf(enPassantSquare)];
+    return key;
+}
+
+void Board::setPiece(const Position &pos, const Piece *piece)
 {
     if (pos.isValid())
     {
-        squares[pos.getRow()][pos.getCol()] = std::move(piece);
+        take(pos.getSquare());
+        if (piece)
+            put(pos.getSquare(), pieceCode(piece));
     }
 }
 
-std::unique_ptr<Piece> Board::removePiece(const Position &pos)
+const Piece *Board::removePiece(const Position &pos)
 {
     if (!pos.isValid())
         return nullptr;
-    return std::move(squares[pos.getRow()][pos.getCol()]);
+    return codePiece(take(pos.getSquare()));
 }
 
 bool Board::isPathClear(const Position &from, const Position &to) const
 {
-    int rowDir = 0, colDir = 0;
-
-    if (to.getRow() > from.getRow())
-        rowDir = 1;
-    else if (to.getRow() < from.getRow())
-        rowDir = -1;
-
-    if (to.getCol() > from.getCol())
-        colDir = 1;
-    else if (to.getCol() < from.getCol())
-        colDir = -1;
-
-    int currentRow = from.getRow() + rowDir;
-    int currentCol = from.getCol() + colDir;
-
-    while (currentRow != to.getRow() || currentCol != to.getCol())
-    {
-        if (!isEmpty(currentRow, currentCol))
-        {
-            return false;
-        }
-        currentRow += rowDir;
-        currentCol += colDir;
-    }
-
-    return true;
+    return !(betweenMask(from.getSquare(), to.getSquare()) & getOccupied());
 }
 
 bool Board::isUnderAttack(const Position &pos, Color byColor) const
 {
-    for (int i = 0; i < 8; i++)
-    {
-        for (int j = 0; j < 8; j++)
-        {
-            Piece *piece = getPiece(i, j);
-            if (piece && piece->getColor() == byColor)
-            {
-                if (piece->isValidMove(pos, *this))
-                {
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
+    return getAttackers(pos, byColor) != 0;
+}
+
+Bitboard Board::getAttackers(const Position &pos, Color byColor) const
+{
+    Square square = pos.getSquare();
+    Bitboard occupied = getOccupied();
+    Color defender = (byColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
+
+    // Look outwards from the square: a piece attacks it if it stands where the same piece would attack from
+    Bitboard queens = getPieces(byColor, PieceType::QUEEN);
+    return (pawnAttacks(defender, square) & getPieces(byColor, PieceType::PAWN)) |
+           (knightAttacks(square) & getPieces(byColor, PieceType::KNIGHT)) |
+           (kingAttacks(square) & getPieces(byColor, PieceType::KING)) |
+           (bishopAttacks(square, occupied) & (getPieces(byColor, PieceType::BISHOP) | queens)) |
+           (rookAttacks(square, occupied) & (getPieces(byColor, PieceType::ROOK) | queens));
 }
 
 Position Board::getKingPosition(Color color) const
 {
-    for (int i = 0; i < 8; i++)
-    {
-        for (int j = 0; j < 8; j++)
-        {
-            Piece *piece = getPiece(i, j);
-            if (piece && piece->getColor() == color && piece->template isType<King>())
-            {
-                return Position(i, j);
-            }
-        }
-    }
-    return Position(-1, -1);
+    Bitboard king = getPieces(color, PieceType::KING);
+    if (!king)
+        return Position(-1, -1);
+    return Position::fromSquare((Square)popLowest(king));
 }
 
 bool Board::isInCheck(Color color) const
@@ -215,37 +417,88 @@ bool Board::isInCheck(Color color) const
     return isUnderAttack(kingPos, enemyColor);
 }
 
-bool Board::wouldBeInCheck(const Position &from, const Position &to, Color color)
+bool Board::wouldBeInCheck(const Position &from, const Position &to, Color color) const
 {
     if (!from.isValid() || !to.isValid())
         return true;
     if (isEmpty(from))
         return true;
 
-    // Save the current state
-    std::unique_ptr<Piece> movingPiece = removePiece(from);
-    std::unique_ptr<Piece> capturedPiece = removePiece(to);
+    // Try the move on a copy
+    Board copy = *this;
+    copy.movePiece(from, to);
+    return copy.isInCheck(color);
+}
 
-    // Backup flags
-    bool hadMovedFlag = movingPiece->hasMovedBefore();
-    Position originalPos = from;
+MoveUndo Board::makeMove(const Move &move)
+{
+    MoveUndo undo;
+    Square from = move.getFrom().getSquare();
+    Square to = move.getTo().getSquare();
 
-    // Simulate the move
-    movingPiece->setPosition(to);
-    setPiece(to, std::move(movingPiece));
+    undo.castlingRights = castlingRights;
+    undo.enPassantSquare = enPassantSquare;
+    undo.halfmoveClock = halfmoveClock;
 
-    bool checkStatus = isInCheck(color);
+    uint8_t code = take(from);
+    PieceType type = codeType(code);
+    bool isPawn = type == PieceType::PAWN;
+    int colDiff = colOf(to) - colOf(from);
 
-    // Undo the move
-    std::unique_ptr<Piece> restorePiece = removePiece(to);
-    restorePiece->setPosition(originalPos);
-    restorePiece->setHasMoved(hadMovedFlag);
-    setPiece(originalPos, std::move(restorePiece));
+    // Castling: the king moves two squares and the rook jumps over it
+    if (type == PieceType::KING && std::abs(colDiff) == 2)
+    {
+        put(colDiff > 0 ? to - 1 : to + 1, take(colDiff > 0 ? from + 3 : from - 4));
+    }
 
-    // Restore captured piece if any
-    if (capturedPiece)
-        setPiece(to, std::move(capturedPiece));
+    // En passant is the only diagonal pawn move onto an empty square
+    undo.capturedAt = (isPawn && colDiff != 0 && !codeAt(to)) ? makeSquare(rowOf(from), colOf(to)) : to;
+    undo.captured = take(undo.capturedAt);
 
-    return checkStatus;
+    enPassantSquare = NO_SQUARE;
+    if (isPawn && distance(from, to) == 2 && colDiff == 0)
+    {
+        enPassantSquare = (Square)((from + to) / 2);
+    }
+
+    if (move.getPromotion())
+        code = pieceCode((PieceType)pieceTypeIndex(move.getPromotion()), codeColor(code));
+    put(to, code);
+
+    setCastlingRights(castlingRights & castlingMasks.mask[from] & castlingMasks.mask[to]);
+    halfmoveClock = (isPawn || undo.captured) ? 0 : halfmoveClock + 1;
+    if (sideToMove == Color::BLACK)
+        fullmoveNumber++;
+    sideToMove = (sideToMove == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    key ^= ZOBRIST_KEYS.side;
+
+    return undo;
 }
 
+void Board::unmakeMove(const Move &move, MoveUndo &undo)
+{
+    Square from = move.getFrom().getSquare();
+    Square to = move.getTo().getSquare();
+
+    sideToMove = (sideToMove == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    key ^= ZOBRIST_KEYS.side;
+    if (sideToMove == Color::BLACK)
+        fullmoveNumber--;
+    halfmoveClock = undo.halfmoveClock;
+    setCastlingRights(undo.castlingRights);
+    enPassantSquare = undo.enPassantSquare;
+
+    uint8_t code = take(to);
+    if (move.getPromotion())
+        code = pieceCode(PieceType::PAWN, codeColor(code));
+    put(from, code);
+
+    if (undo.captured)
+        put(undo.capturedAt, undo.captured);
+
+    int colDiff = colOf(to) - colOf(from);
+    if (codeType(code) == PieceType::KING && std::abs(colDiff) == 2)
+    {
+        put(colDiff > 0 ? from + 3 : from - 4, take(colDiff > 0 ? to - 1 : to + 1));
+    }
+}
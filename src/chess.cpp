@@ -0,0 +1,318 @@
+#include "chess.h"
+#include "Board.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include "SmpSearch.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+struct chess_board
+{
+    Board board;
+};
+
+struct chess_search
+{
+    SmpSearch search;
+    std::atomic<uint64_t> generation{0};      ///< Number of the latest chess_search_run call
+    std::atomic<uint64_t> stopGeneration{0};  ///< Run that chess_search_stop last asked to end
+
+    chess_search(unsigned threads, size_t hashMb) : search(threads, hashMb, NumaPolicy::OFF) {}
+};
+
+namespace
+{
+    // Promotion piece of each code of bits 12-14
+    const char PROMOTIONS[] = {0, 'N', 'B', 'R', 'Q'};
+
+    // The interface numbers squares from a1, the board from a8
+    int flipSquare(int square)
+    {
+        return square ^ 56;
+    }
+
+    chess_move pack(const Move &move)
+    {
+        if (move.isNull())
+            return CHESS_MOVE_NONE;
+        int promotion = 0;
+        for (int i = 1; i < 5; i++)
+            if (PROMOTIONS[i] == move.getPromotion())
+                promotion = i;
+        return (chess_move)(flipSquare(move.getFrom().getSquare()) | (flipSquare(move.getTo().getSquare()) << 6) |
+                            (promotion << 12));
+    }
+
+    // The legal move a packed move stands for, or a null move if it is not legal
+    Move unpack(Board &board, chess_move packed)
+    {
+        int promotion = (packed >> 12) & 7;
+        if (packed == CHESS_MOVE_NONE || promotion > 4 || (packed >> 15))
+            return Move();
+        Move wanted(Position::fromSquare((Square)flipSquare(packed & 63)),
+                    Position::fromSquare((Square)flipSquare((packed >> 6) & 63)), PROMOTIONS[promotion]);
+
+        MoveList legal;
+        MoveGen::generate(GenType::LEGAL, board, board.getSideToMove(), legal);
+        for (const Move &move : legal)
+            if (move == wanted)
+                return move;
+        return Move();
+    }
+
+    // Copies text and its terminator into a caller buffer
+    int copyOut(const char *text, size_t length, char *out, size_t size)
+    {
+        if (!out || length >= size)
+            return CHESS_ERROR_BUFFER;
+        std::memcpy(out, text, length + 1);
+        return (int)length;
+    }
+}
+
+extern "C"
+{
+    int chess_api_version(void)
+    {
+        return CHESS_API_VERSION;
+    }
+
+    chess_board *chess_board_create(void)
+    {
+        chess_board *board = new (std::nothrow) chess_board();
+        if (board)
+            board->board.initialize();
+        return board;
+    }
+
+    chess_board *chess_board_clone(const chess_board *board)
+    {
+        return new (std::nothrow) chess_board(*board);
+    }
+
+    void chess_board_free(chess_board *board)
+    {
+        delete board;
+    }
+
+    chess_result chess_board_set_fen(chess_board *board, const char *fen)
+    {
+        if (!fen)
+            return CHESS_ERROR_INVALID;
+        try
+        {
+            // Parse into a copy so a bad FEN leaves the board as it was
+            Board parsed;
+            if (!parsed.loadFEN(fen))
+                return CHESS_ERROR_INVALID;
+            board->board = parsed;
+            return CHESS_OK;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return CHESS_ERROR_MEMORY;
+        }
+        catch (const std::exception &)
+        {
+            return CHESS_ERROR_INVALID;
+        }
+    }
+
+    int chess_board_get_fen(const chess_board *board, char *out, size_t size)
+    {
+        try
+        {
+            std::string fen = board->board.toFEN();
+            return copyOut(fen.c_str(), fen.length(), out, size);
+        }
+        catch (const std::bad_alloc &)
+        {
+            return CHESS_ERROR_MEMORY;
+        }
+    }
+
+    chess_color chess_board_side_to_move(const chess_board *board)
+    {
+        return board->board.getSideToMove() == Color::WHITE ? CHESS_WHITE : CHESS_BLACK;
+    }
+
+    int chess_board_legal_moves(const chess_board *board, chess_move *out, size_t capacity)
+    {
+        Board copy = board->board;
+        MoveList legal;
+        MoveGen::generate(GenType::LEGAL, copy, copy.getSideToMove(), legal);
+        size_t count = (size_t)legal.size();
+        if (count > capacity || (!out && count > 0))
+            return CHESS_ERROR_BUFFER;
+        for (size_t i = 0; i < count; i++)
+            out[i] = pack(legal[(int)i]);
+        return (int)count;
+    }
+
+    chess_result chess_board_apply(chess_board *board, chess_move move)
+    {
+        Move legal = unpack(board->board, move);
+        if (legal.isNull())
+            return CHESS_ERROR_ILLEGAL;
+        board->board.makeMove(legal);
+        return CHESS_OK;
+    }
+
+    chess_status chess_board_status(const chess_board *board)
+    {
+        Board copy = board->board;
+        Color us = copy.getSideToMove();
+        MoveList legal;
+        MoveGen::generate(GenType::LEGAL, copy, us, legal);
+        bool inCheck = copy.isInCheck(us);
+        if (legal.empty())
+            return inCheck ? CHESS_CHECKMATE : CHESS_STALEMATE;
+        if (copy.getHalfmoveClock() >= 100)
+            return CHESS_DRAW;
+        return inCheck ? CHESS_CHECK : CHESS_ONGOING;
+    }
+
+    chess_result chess_move_from_uci(const chess_board *board, const char *uci, chess_move *move)
+    {
+        size_t length = uci ? std::strlen(uci) : 0;
+        if (length != 4 && length != 5)
+            return CHESS_ERROR_INVALID;
+        try
+        {
+            Board copy = board->board;
+            Move parsed = Notation::fromUci(copy, uci);
+            if (parsed.isNull())
+                return CHESS_ERROR_ILLEGAL;
+            *move = pack(parsed);
+            return CHESS_OK;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return CHESS_ERROR_MEMORY;
+        }
+    }
+
+    int chess_move_to_uci(chess_move move, char *out, size_t size)
+    {
+        int promotion = (move >> 12) & 7;
+        if (move == CHESS_MOVE_NONE || promotion > 4 || (move >> 15))
+            return CHESS_ERROR_INVALID;
+
+        char text[CHESS_MOVE_TEXT_SIZE];
+        int from = move & 63, to = (move >> 6) & 63;
+        size_t length = 0;
+        text[length++] = (char)('a' + from % 8);
+        text[length++] = (char)('1' + from / 8);
+        text[length++] = (char)('a' + to % 8);
+        text[length++] = (char)('1' + to / 8);
+        if (promotion)
+            text[length++] = (char)(PROMOTIONS[promotion] - 'A' + 'a');
+        text[length] = '\0';
+        return copyOut(text, length, out, size);
+    }
+
+    chess_result chess_move_from_san(const chess_board *board, const char *san, chess_move *move)
+    {
+        if (!san)
+            return CHESS_ERROR_INVALID;
+        try
+        {
+            Board copy = board->board;
+            Move parsed = Notation::fromSan(copy, san);
+            if (parsed.isNull())
+                return CHESS_ERROR_ILLEGAL;
+            *move = pack(parsed);
+            return CHESS_OK;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return CHESS_ERROR_MEMORY;
+        }
+    }
+
+    int chess_move_to_san(const chess_board *board, chess_move move, char *out, size_t size)
+    {
+        Board copy = board->board;
+        Move legal = unpack(copy, move);
+        if (legal.isNull())
+            return CHESS_ERROR_ILLEGAL;
+
+        char text[Notation::MAX_SAN_LENGTH + 1];
+        size_t length = Notation::writeSan(copy, legal, text);
+        return copyOut(text, length, out, size);
+    }
+
+    chess_search *chess_search_create(unsigned threads, size_t hash_mb)
+    {
+        try
+        {
+            return new chess_search(std::max(1u, threads), std::max<size_t>(1, hash_mb));
+        }
+        catch (const std::exception &)
+        {
+            return nullptr;
+        }
+    }
+
+    void chess_search_free(chess_search *search)
+    {
+        delete search;
+    }
+
+    chess_result chess_search_run(chess_search *search, const chess_board *board, const chess_search_limits *limits,
+                                  chess_search_info *info)
+    {
+        SearchLimits budget;
+        if (limits)
+        {
+            if (limits->depth > 0)
+                budget.depth = std::min(limits->depth, budget.depth);
+            budget.nodes = limits->nodes;
+            budget.timeMs = std::max<int64_t>(0, limits->time_ms);
+        }
+
+        // SmpSearch::run clears its stop flag as it starts, which would lose a stop made just
+        // after this call began; the stop is also recorded against this run and applied after
+        // every iteration. Stops made for earlier runs carry older numbers and are ignored.
+        uint64_t run = ++search->generation;
+        try
+        {
+            SearchInfo result = search->search.run(board->board, budget, [search, run](const SearchInfo &)
+                                                   {
+                                                       if (search->stopGeneration == run)
+                                                           search->search.stop();
+                                                   });
+
+            *info = chess_search_info();
+            info->best_move = pack(result.bestMove());
+            info->score = result.score;
+            if (Search::isMateScore(result.score))
+                info->mate = result.score > 0 ? (Search::MATE_SCORE - result.score + 1) / 2
+                                              : -(Search::MATE_SCORE + result.score + 1) / 2;
+            info->depth = result.depth;
+            info->nodes = search->search.getNodes();
+            info->time_ms = result.timeMs;
+            info->pv_length = std::min<size_t>(result.pv.size(), CHESS_MAX_PV);
+            for (size_t i = 0; i < info->pv_length; i++)
+                info->pv[i] = pack(result.pv[i]);
+            return CHESS_OK;
+        }
+        catch (const std::exception &)
+        {
+            return CHESS_ERROR_MEMORY;
+        }
+    }
+
+    void chess_search_stop(chess_search *search)
+    {
+        search->stopGeneration = search->generation.load();
+        search->search.stop();
+    }
+
+    void chess_search_clear(chess_search *search)
+    {
+        search->search.clearTables();
+    }
+}
@@ -1,26 +1,56 @@
 #include "Game.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include "Parallel.h"
 #include <iostream>
 #include <cctype>
+#include <chrono>
+#include <cstdio>
 #include <algorithm>
 #include <string>
 
+namespace
+{
+    // Formats thinking time as "m:ss"
+    std::string formatClock(int64_t ms)
+    {
+        char text[24];
+        std::snprintf(text, sizeof(text), "%lld:%02lld", (long long)(ms / 60000), (long long)(ms / 1000 % 60));
+        return text;
+    }
+}
+
 void Game::start()
 {
     std::cout << "=================================\n";
     std::cout << "    Welcome to CLI Chess Game    \n";
     std::cout << "=================================\n\n";
 
-    // Get player names
+    // Get player names; the engine's side needs none
     std::string whiteName, blackName;
-    std::cout << "Enter name for White player: ";
-    std::getline(std::cin, whiteName);
-    if (whiteName.empty())
-        whiteName = "White";
+    if (engine && engineColor == Color::WHITE)
+    {
+        whiteName = "Engine";
+    }
+    else
+    {
+        std::cout << "Enter name for White player: ";
+        input.readLine(whiteName);
+        if (whiteName.empty())
+            whiteName = "White";
+    }
 
-    std::cout << "Enter name for Black player: ";
-    std::getline(std::cin, blackName);
-    if (blackName.empty())
-        blackName = "Black";
+    if (engine && engineColor == Color::BLACK)
+    {
+        blackName = "Engine";
+    }
+    else
+    {
+        std::cout << "Enter name for Black player: ";
+        input.readLine(blackName);
+        if (blackName.empty())
+            blackName = "Black";
+    }
 
     // Set player names
     whitePlayer.setName(whiteName);
@@ -29,11 +59,14 @@ void Game::start()
     std::cout << "\n"
               << whiteName << " (White) vs " << blackName << " (Black)\n";
     std::cout << "\nCommands:\n";
-    std::cout << "  - Move: e2 e4\n";
+    std::cout << "  - Move: e2 e4 or e2e4; several moves and commands may share a line\n";
     std::cout << "  - Castle Kingside: O-O or 0-0\n";
     std::cout << "  - Castle Queenside: O-O-O or 0-0-0\n";
+    std::cout << "  - Premove for your next turn: premove g1 f3 or premove e7e8n\n";
+    std::cout << "  - Background analysis on/off: analyze\n";
     std::cout << "  - Quit: quit or exit\n\n";
 
+    turnStart = std::chrono::steady_clock::now();
     while (!gameOver)
     {
         try
@@ -43,8 +76,12 @@ void Game::start()
         catch (const std::exception &e)
         {
             std::cout << "Unexpected error: " << e.what() << "\n";
+
+            // The rest of a pasted line was meant to follow the failed command
+            input.discardLine();
         }
     }
+    analyzer.stop();
 
     std::cout << "\n=================================\n";
     std::cout << "         Game Over!\n";
@@ -53,30 +90,127 @@ void Game::start()
     {
         std::cout << "Winner: " << winner << "!\n";
     }
+    else if (result == "*")
+    {
+        std::cout << "Result: Game abandoned.\n";
+    }
     else
     {
         std::cout << "Result: Draw!\n";
     }
     std::cout << "=================================\n";
+
+    std::vector<std::string> annotations;
+    if (review && !history.empty())
+    {
+        annotations = reviewGame();
+    }
+
+    // The coach's remarks go into the PGN as comments
+    coach.cancel();
+    printCoachNotes();
+    std::vector<std::string> notes = getCoachNotes();
+    for (size_t ply = 0; ply < notes.size(); ply++)
+    {
+        if (notes[ply].empty())
+        {
+            continue;
+        }
+        annotations.resize(history.size());
+        annotations[ply] += (annotations[ply].empty() ? "{" : " {") + notes[ply] + "}";
+    }
+
+    if (pgnWriter)
+    {
+        exportPgn(*pgnWriter, annotations);
+    }
+}
+
+std::vector<std::string> Game::reviewGame()
+{
+    std::cout << "\nReviewing the game...\n";
+
+    Board start;
+    start.initialize();
+    std::vector<Move> moves;
+    for (const MoveRecord &record : history)
+    {
+        moves.push_back(record.move);
+    }
+
+    SearchLimits limits;
+    limits.timeMs = 30;
+    Annotator annotator(defaultThreadCount());
+    std::vector<MoveReview> reviews = annotator.annotate(start, moves, limits);
+
+    std::vector<std::string> annotations;
+    int flagged = 0;
+    for (size_t i = 0; i < reviews.size(); i++)
+    {
+        annotations.push_back(Annotator::format(reviews[i]));
+        if (reviews[i].judgement != MoveJudgement::MISTAKE && reviews[i].judgement != MoveJudgement::BLUNDER)
+        {
+            continue;
+        }
+
+        // Drop the NAG; the comment already names the verdict
+        std::string text = annotations.back();
+        text = text.substr(text.find('{') + 1);
+        text.pop_back();
+        std::cout << "  " << i / 2 + 1 << (i % 2 ? "... " : ". ") << history[i].san
+                  << (reviews[i].judgement == MoveJudgement::BLUNDER ? "?? " : "? ") << text << "\n";
+        flagged++;
+    }
+    if (!flagged)
+    {
+        std::cout << "  No mistakes found.\n";
+    }
+    return annotations;
 }
 
 void Game::playTurn()
 {
-    board.display();
+    // While commands are still waiting to be read, nobody is looking at the board
+    bool interactive = !input.hasPending();
+    if (interactive)
+    {
+        renderer.render(board);
+        printCoachNotes();
 
-    std::cout << currentPlayer->getName() << "'s turn";
+        // Follow the game with the analysis; it keeps running if the position is unchanged
+        if (analyzer.isRunning())
+        {
+            analyzer.analyze(board);
+        }
+    }
+
+    if (engine && currentPlayer->getColor() == engineColor)
+    {
+        playEngineMove();
+        return;
+    }
 
     bool inCheck = board.isInCheck(currentPlayer->getColor());
     currentPlayer->setIsInCheck(inCheck);
 
-    if (inCheck)
+    if (interactive)
     {
-        std::cout << " (in CHECK!)";
+        std::cout << currentPlayer->getName() << "'s turn [" << formatClock(currentPlayer->getClockMs()) << "]";
+        if (inCheck)
+        {
+            std::cout << " (in CHECK!)";
+        }
+        std::cout << "\nEnter move: ";
+        std::cout.flush();
     }
-    std::cout << "\nEnter move: ";
 
     std::string input1, input2;
-    std::cin >> input1;
+    if (!input.readToken(input1))
+    {
+        // End of input: nobody is left to play
+        gameOver = true;
+        return;
+    }
 
     if (input1 == "quit" || input1 == "exit" || input1 == "q")
     {
@@ -89,7 +223,7 @@ void Game::playTurn()
         std::cout << "Enter choice (1-3): ";
 
         std::string choice;
-        std::cin >> choice;
+        input.readToken(choice);
 
         if (choice == "1")
         {
@@ -97,6 +231,7 @@ void Game::playTurn()
             gameOver = true;
             Player *winnerPlayer = (currentPlayer == &whitePlayer) ? &blackPlayer : &whitePlayer;
             winner = winnerPlayer->getName();
+            result = winnerPlayer->isWhite() ? "1-0" : "0-1";
             std::cout << "\n"
                       << currentPlayer->getName() << " resigns. " << winner << " wins!\n";
         }
@@ -109,11 +244,12 @@ void Game::playTurn()
             std::cout << opponent->getName() << ", do you accept the draw? (y/n): ";
 
             std::string response;
-            std::cin >> response;
+            input.readToken(response);
 
             if (response == "y" || response == "Y" || response == "yes")
             {
                 gameOver = true;
+                result = "1/2-1/2";
                 std::cout << "\nDraw agreed by both players.\n";
             }
             else
@@ -128,9 +264,59 @@ void Game::playTurn()
         return;
     }
 
-    if (input1.length() == 4)
+    if (input1 == "premove")
+    {
+        // "e2e4", "e7e8n", "e2 e4" or "e7 e8n"
+        std::string from, to;
+        input.readToken(from);
+        if (from.length() == 4 || from.length() == 5)
+        {
+            to = from.substr(2);
+            from = from.substr(0, 2);
+        }
+        else
+        {
+            input.readToken(to);
+        }
+
+        char promotion = 0;
+        if (to.length() == 3)
+        {
+            promotion = (char)std::toupper((unsigned char)to[2]);
+            to.pop_back();
+            if (promotion != 'Q' && promotion != 'R' && promotion != 'B' && promotion != 'N')
+            {
+                throw std::runtime_error("Invalid premove!");
+            }
+        }
+        Position fromPos = parsePosition(from);
+        Position toPos = parsePosition(to);
+        if (!fromPos.isValid() || !toPos.isValid())
+        {
+            throw std::runtime_error("Invalid premove!");
+        }
+        currentPlayer->setPremove(Move(fromPos, toPos, promotion));
+        std::cout << "Premove " << from << " " << to;
+        if (promotion)
+        {
+            std::cout << " =" << promotion;
+        }
+        std::cout << " queued for your next turn.\n";
+        return;
+    }
+
+    if (input1 == "analyze")
     {
-        std::cout << "Invalid Format!!! try again" << std::endl;
+        if (analyzer.isRunning())
+        {
+            analyzer.stop();
+            std::cout << "Analysis off.\n";
+        }
+        else
+        {
+            std::cout << "Analysis on.\n";
+            analyzer.analyze(board);
+        }
         return;
     }
 
@@ -146,12 +332,24 @@ void Game::playTurn()
         return;
     }
 
+    // Coordinates in one token, as in "e2e4" or "e7e8q"
+    if ((input1.length() == 4 || input1.length() == 5) && parsePosition(input1.substr(0, 2)).isValid() &&
+        parsePosition(input1.substr(2, 2)).isValid())
+    {
+        char promotion = input1.length() == 5 ? input1[4] : 0;
+        if (!makeMove(input1.substr(0, 2), input1.substr(2, 2), promotion))
+        {
+            throw std::runtime_error("Invalid move!");
+        }
+        return;
+    }
+
     Position check = parsePosition(input1);
     if (!check.isValid())
     {
         throw std::runtime_error("Invalid move!");
     }
-    std::cin >> input2;
+    input.readToken(input2);
 
     if (!makeMove(input1, input2))
     {
@@ -159,7 +357,7 @@ void Game::playTurn()
     }
 }
 
-bool Game::makeMove(const std::string &from, const std::string &to)
+bool Game::makeMove(const std::string &from, const std::string &to, char promotion)
 {
     Position fromPos = parsePosition(from);
     Position toPos = parsePosition(to);
@@ -169,7 +367,7 @@ bool Game::makeMove(const std::string &from, const std::string &to)
         return false;
     }
 
-    Piece *piece = board.getPiece(fromPos);
+    const Piece *piece = board.getPiece(fromPos);
     if (!piece)
     {
         throw std::runtime_error("No piece at that position!");
@@ -180,88 +378,93 @@ bool Game::makeMove(const std::string &from, const std::string &to)
         throw std::runtime_error("That's not your piece!");
     }
 
-    if (!piece->isValidMove(toPos, board))
+    // The turn's legal moves decide; a promotion matches once per piece
+    bool found = false;
+    bool promotes = false;
+    for (const Move &move : legalMoves)
     {
-        return false;
-    }
-
-    // Check if move would leave king in check
-    if (board.wouldBeInCheck(fromPos, toPos, currentPlayer->getColor()))
-    {
-        throw std::runtime_error("Move would leave king in check!");
+        if (move.getFrom() == fromPos && move.getTo() == toPos)
+        {
+            found = true;
+            promotes = move.getPromotion() != 0;
+        }
     }
 
-    // Check for captured piece BEFORE moving
-    Piece *capturedPiece = board.getPiece(toPos);
-    if (capturedPiece && capturedPiece->getColor() != currentPlayer->getColor())
+    if (!found)
     {
-        // Calculate piece value (simplified: Pawn=1, Knight/Bishop=3, Rook=5, Queen=9, King=0)
-        int pieceValue = 0;
-        std::string pieceName = capturedPiece->getName();
-        if (pieceName == "Pawn")
-            pieceValue = 1;
-        else if (pieceName == "Knight" || pieceName == "Bishop")
-            pieceValue = 3;
-        else if (pieceName == "Rook")
-            pieceValue = 5;
-        else if (pieceName == "Queen")
-            pieceValue = 9;
-
-        currentPlayer->addCapturedPieceValue(pieceValue);
+        // Say why, if the piece could otherwise make the move
+        for (const Move &move : MoveGen::generatePseudoLegal(board, currentPlayer->getColor()))
+        {
+            if (move.getFrom() == fromPos && move.getTo() == toPos)
+            {
+                throw std::runtime_error("Move would leave king in check!");
+            }
+        }
+        return false;
     }
 
-    // Check for en passant BEFORE moving
-    bool isEnPassant = SpecialMoves::isEnPassantMove(fromPos, toPos, board);
-
-    // Check if pawn moves two squares (set en passant target)
-    bool isPawnDoubleMove = false;
-    if (piece->template isType<Pawn>())
+    // Ask for the promotion piece, unless given, so the move can be matched in full
+    if (promotes)
     {
-        int rowDiff = std::abs(toPos.getRow() - fromPos.getRow());
-        if (rowDiff == 2)
+        promotion = (char)std::toupper((unsigned char)promotion);
+        if (promotion != 'Q' && promotion != 'R' && promotion != 'B' && promotion != 'N')
         {
-            isPawnDoubleMove = true;
+            promotion = handlePromotion();
         }
     }
-
-    // Clear en passant flag
-    board.clearEnPassant();
-
-    // Perform the move
-    if (isEnPassant)
+    else
     {
-        SpecialMoves::performEnPassant(fromPos, toPos, board);
+        promotion = 0;
     }
-    else
+
+    // Play the generator's move, so the board updates its clocks and special-move state itself
+    Move wanted(fromPos, toPos, promotion);
+    for (const Move &move : legalMoves)
     {
-        if (!board.movePiece(fromPos, toPos))
+        if (move == wanted)
         {
-            return false;
+            playMove(move, coaching);
+            return true;
         }
     }
+    return false;
+}
 
-    // Set en passant target if pawn moved two squares
-    if (isPawnDoubleMove)
+void Game::playEngineMove()
+{
+    Move move = engine->chooseMove(board);
+    const SearchInfo &info = engine->getLastInfo();
+    bool mcts = engine->getType() == EngineType::MCTS;
+
+    // Score from the engine's point of view, in pawns
+    char score[16], reused[16];
+    std::snprintf(score, sizeof(score), "%+.2f", info.score / 100.0);
+    std::snprintf(reused, sizeof(reused), "%.1f%%", engine->getReusedFraction() * 100.0);
+    std::cout << currentPlayer->getName() << " plays " << Notation::toSan(board, move)
+              << "  (depth " << info.depth << ", " << (Search::isMateScore(info.score) ? "mate" : score)
+              << ", " << info.nodes << (mcts ? " playouts" : " nodes") << ", "
+              << reused << " reused)\n";
+
+    playMove(move);
+}
+
+void Game::playMove(const Move &move, bool check)
+{
+    Board before = board;
+    recordMove(move);
+
+    const Piece *capturedPiece = board.getPiece(move.getTo());
+    if (capturedPiece && capturedPiece->getColor() != currentPlayer->getColor())
     {
-        int midRow = (fromPos.getRow() + toPos.getRow()) / 2;
-        board.setEnPassantTarget(Position(midRow, fromPos.getCol()));
+        currentPlayer->addCapturedPieceValue(materialValue(capturedPiece->getType()) / 100);
     }
 
-    // Check for pawn promotion
-    piece = board.getPiece(toPos);
-    if (piece && piece->template isType<Pawn>())
+    board.makeMove(move);
+    if (check)
     {
-        if ((piece->getColor() == Color::WHITE && toPos.getRow() == 0) ||
-            (piece->getColor() == Color::BLACK && toPos.getRow() == 7))
-        {
-            handlePromotion(toPos);
-        }
+        coach.check(history.size() - 1, before, move);
     }
-
-    switchPlayer();
-    checkGameStatus();
-
-    return true;
+    finishMove();
 }
 
 Position Game::parsePosition(const std::string &pos)
@@ -280,77 +483,51 @@ Position Game::parsePosition(const std::string &pos)
     return Position(8 - (row - '0'), col - 'a');
 }
 
-void Game::handlePromotion(const Position &pos)
+char Game::handlePromotion()
 {
     std::cout << "Pawn promotion! Choose piece (Q/R/B/N): ";
-    char choice;
-    std::cin >> choice;
+    std::string text;
+    input.readToken(text);
 
-    SpecialMoves::promotePawn(pos, choice, board);
+    char choice = (char)std::toupper((unsigned char)(text.empty() ? 'Q' : text[0]));
+    if (choice != 'Q' && choice != 'R' && choice != 'B' && choice != 'N')
+    {
+        choice = 'Q';
+    }
+    return choice;
 }
 
 void Game::handleCastling(const std::string &command)
 {
     bool kingSide = (command == "kingside");
+    int row = (currentPlayer->getColor() == Color::WHITE) ? 7 : 0;
 
-    if (kingSide)
-    {
-        if (!SpecialMoves::canCastleKingSide(currentPlayer->getColor(), board))
-        {
-            throw std::runtime_error("Cannot castle kingside!");
-        }
-        SpecialMoves::performCastling(currentPlayer->getColor(), true, board);
-    }
-    else
+    // Castling is the king moving two squares
+    Move castle(Position(row, 4), Position(row, kingSide ? 6 : 2));
+    const Piece *king = board.getPiece(castle.getFrom());
+    if (king && king->getType() == PieceType::KING)
     {
-        if (!SpecialMoves::canCastleQueenSide(currentPlayer->getColor(), board))
+        for (const Move &move : legalMoves)
         {
-            throw std::runtime_error("Cannot castle queenside!");
-        }
-        SpecialMoves::performCastling(currentPlayer->getColor(), false, board);
-    }
-
-    board.clearEnPassant();
-    switchPlayer();
-    checkGameStatus();
-}
-
-bool Game::hasValidMoves(Color color)
-{
-    for (int i = 0; i < 8; i++)
-    {
-        for (int j = 0; j < 8; j++)
-        {
-            Piece *piece = board.getPiece(i, j);
-            if (piece && piece->getColor() == color)
+            if (move == castle)
             {
-                Position from(i, j);
-
-                for (int ti = 0; ti < 8; ti++)
-                {
-                    for (int tj = 0; tj < 8; tj++)
-                    {
-                        Position to(ti, tj);
-                        if (piece->isValidMove(to, board))
-                        {
-                            if (!board.wouldBeInCheck(from, to, color))
-                            {
-                                return true;
-                            }
-                        }
-                    }
-                }
+                playMove(move, coaching);
+                return;
             }
         }
     }
-    return false;
+    throw std::runtime_error(kingSide ? "Cannot castle kingside!" : "Cannot castle queenside!");
 }
 
 void Game::checkGameStatus()
 {
     bool inCheck = board.isInCheck(currentPlayer->getColor());
     currentPlayer->setIsInCheck(inCheck);
-    bool hasLegalMoves = hasValidMoves(currentPlayer->getColor());
+
+    // Cached for the rest of the turn, so a premove can be checked without generating again
+    legalMoves.clear();
+    MoveGen::generate(GenType::LEGAL, board, currentPlayer->getColor(), legalMoves);
+    bool hasLegalMoves = !legalMoves.empty();
 
     if (!hasLegalMoves)
     {
@@ -360,13 +537,109 @@ void Game::checkGameStatus()
             // The other player wins
             Player *winnerPlayer = (currentPlayer == &whitePlayer) ? &blackPlayer : &whitePlayer;
             winner = winnerPlayer->getName();
+            result = winnerPlayer->isWhite() ? "1-0" : "0-1";
             std::cout << "\nCheckmate! " << currentPlayer->getName() << " is in checkmate.\n";
             std::cout << winner << " wins the game!\n";
         }
         else
         {
+            result = "1/2-1/2";
             std::cout << "\nStalemate! " << currentPlayer->getName() << " has no legal moves.\n";
             std::cout << "The game is a draw!\n";
         }
     }
-}
\ No newline at end of file
+}
+
+void Game::finishMove()
+{
+    auto now = std::chrono::steady_clock::now();
+    currentPlayer->addClockMs(std::chrono::duration_cast<std::chrono::milliseconds>(now - turnStart).count());
+    turnStart = now;
+
+    switchPlayer();
+    checkGameStatus();
+
+    if (!gameOver && currentPlayer->hasPremove())
+    {
+        playPremove();
+    }
+}
+
+void Game::playPremove()
+{
+    Move premove = currentPlayer->takePremove();
+
+    // A premove to the last rank without a piece letter promotes to a queen
+    for (const Move &move : legalMoves)
+    {
+        if (move.getFrom() == premove.getFrom() && move.getTo() == premove.getTo() &&
+            (move.getPromotion() == premove.getPromotion() || (!premove.getPromotion() && move.getPromotion() == 'Q')))
+        {
+            std::cout << currentPlayer->getName() << " premoves " << Notation::toSan(board, move) << "\n";
+            playMove(move, coaching);
+            return;
+        }
+    }
+}
+
+void Game::recordMove(const Move &move)
+{
+    // A new move makes any check of the previous one stale
+    if (coaching)
+    {
+        coach.cancel();
+    }
+
+    MoveRecord record;
+    record.move = move;
+    Notation::writeSan(board, move, record.san);
+    history.push_back(record);
+}
+
+void Game::setCoaching(bool enabled)
+{
+    coaching = enabled;
+    if (!enabled)
+    {
+        coach.cancel();
+        return;
+    }
+
+    // Runs on a coach thread; the note is printed by the game thread on its next turn
+    auto attach = [this](const CoachNote &note)
+    {
+        std::lock_guard<std::mutex> lock(notesMutex);
+        if (coachNotes.size() <= note.ply)
+        {
+            coachNotes.resize(note.ply + 1);
+        }
+        coachNotes[note.ply] = note.text;
+        unshownNotes.push_back(note.ply);
+    };
+    coach.setListener(attach);
+}
+
+void Game::printCoachNotes()
+{
+    std::lock_guard<std::mutex> lock(notesMutex);
+    for (size_t ply : unshownNotes)
+    {
+        std::cout << "  [coach] " << ply / 2 + 1 << (ply % 2 ? "... " : ". ") << coachNotes[ply] << "\n";
+    }
+    unshownNotes.clear();
+}
+
+std::vector<std::string> Game::getCoachNotes()
+{
+    std::lock_guard<std::mutex> lock(notesMutex);
+    return coachNotes;
+}
+
+void Game::exportPgn(PgnWriter &writer, const std::vector<std::string> &annotations) const
+{
+    PgnHeader header;
+    header.white = whitePlayer.getName();
+    header.black = blackPlayer.getName();
+    header.result = result;
+    writer.writeGame(header, history, annotations);
+}
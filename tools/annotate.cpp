@@ -0,0 +1,159 @@
+#include "Annotator.h"
+#include "Board.h"
+#include "Notation.h"
+#include "Parallel.h"
+#include "Pgn.h"
+#include "PgnWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    int64_t millisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Replays the game's SAN moves; false if one of them is illegal
+    bool replay(const PgnGame &game, Board &start, std::vector<Move> &moves, std::vector<MoveRecord> &records)
+    {
+        std::string fen = game.getTag("FEN");
+        if (fen.empty())
+            start.initialize();
+        else if (!start.loadFEN(fen))
+            return false;
+
+        Board board = start;
+        for (const std::string &san : game.moves)
+        {
+            Move move = Notation::fromSan(board, san);
+            if (move.isNull())
+                return false;
+            MoveRecord record;
+            record.move = move;
+            Notation::writeSan(board, move, record.san);
+            moves.push_back(move);
+            records.push_back(record);
+            board.makeMove(move);
+        }
+        return true;
+    }
+
+    PgnHeader headerOf(const PgnGame &game)
+    {
+        PgnHeader header;
+        auto copyTag = [&game](const char *name, std::string &value)
+        {
+            std::string tag = game.getTag(name);
+            if (!tag.empty())
+                value = tag;
+        };
+        copyTag("Event", header.event);
+        copyTag("Site", header.site);
+        copyTag("Date", header.date);
+        copyTag("Round", header.round);
+        copyTag("White", header.white);
+        copyTag("Black", header.black);
+        header.result = game.result;
+        header.fen = game.getTag("FEN");
+        return header;
+    }
+
+    void printUsage()
+    {
+        std::cerr << "Usage: annotate <games.pgn> -o <annotated.pgn> [--time ms] [--depth n] [--threads n] [--hash mb]\n"
+                  << "Searches every position of every game and writes the games back with blunders ($4),\n"
+                  << "mistakes ($2) and the engine's choices ($1) marked. --time and --depth set the budget\n"
+                  << "of each position's search.\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string inputPath, outputPath;
+    SearchLimits limits;
+    limits.timeMs = 30;
+    unsigned threadCount = defaultThreadCount();
+    size_t hashMb = 64;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue)
+            outputPath = argv[++i];
+        else if (arg == "--time" && hasValue)
+            limits.timeMs = std::atoll(argv[++i]);
+        else if (arg == "--depth" && hasValue)
+            limits.depth = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--threads" && hasValue)
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--hash" && hasValue)
+            hashMb = (size_t)std::max(1, std::atoi(argv[++i]));
+        else if (inputPath.empty() && arg[0] != '-')
+            inputPath = arg;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (inputPath.empty() || outputPath.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        std::ifstream file(inputPath);
+        if (!file)
+            throw std::runtime_error("cannot open " + inputPath);
+        PgnWriter writer(outputPath);
+        Annotator annotator(threadCount, hashMb);
+
+        PgnReader reader(file);
+        PgnGame game;
+        for (int number = 1; reader.next(game); number++)
+        {
+            Board start;
+            std::vector<Move> moves;
+            std::vector<MoveRecord> records;
+            if (!replay(game, start, moves, records))
+            {
+                std::cout << "Game " << number << ": illegal move, skipped\n";
+                continue;
+            }
+
+            auto startTime = std::chrono::steady_clock::now();
+            std::vector<MoveReview> reviews = annotator.annotate(start, moves, limits);
+            int64_t elapsedMs = millisecondsSince(startTime);
+
+            int counts[4] = {0, 0, 0, 0};
+            std::vector<std::string> annotations;
+            for (const MoveReview &review : reviews)
+            {
+                counts[(int)review.judgement]++;
+                annotations.push_back(Annotator::format(review));
+            }
+            writer.writeGame(headerOf(game), records, annotations);
+
+            std::cout << "Game " << number << ": " << game.getTag("White") << " - " << game.getTag("Black")
+                      << ", " << moves.size() << " plies: " << counts[(int)MoveJudgement::BLUNDER] << " blunders, "
+                      << counts[(int)MoveJudgement::MISTAKE] << " mistakes, " << counts[(int)MoveJudgement::BEST]
+                      << " best moves in " << elapsedMs << " ms\n";
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include "Board.h"
+#include "MoveGen.h"
+#include "Numa.h"
+#include "Search.h"
+#include "SmpSearch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    struct BenchPosition
+    {
+        const char *name;
+        const char *fen;
+    };
+
+    // The usual perft test positions; together they cover castling, en passant and promotions
+    const BenchPosition positions[] = {
+        {"start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"},
+        {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"},
+        {"endgame", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"},
+        {"promotions", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"},
+        {"middlegame", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"},
+    };
+
+    uint64_t perftUnmake(Board &board, int depth)
+    {
+        MoveList moves;
+        MoveGen::generate(GenType::LEGAL, board, board.getSideToMove(), moves);
+        if (depth <= 1)
+            return moves.size();
+
+        uint64_t nodes = 0;
+        for (const Move &move : moves)
+        {
+            MoveUndo undo = board.makeMove(move);
+            nodes += perftUnmake(board, depth - 1);
+            board.unmakeMove(move, undo);
+        }
+        return nodes;
+    }
+
+    uint64_t perftCopy(Board &board, int depth)
+    {
+        MoveList moves;
+        MoveGen::generate(GenType::LEGAL, board, board.getSideToMove(), moves);
+        if (depth <= 1)
+            return moves.size();
+
+        uint64_t nodes = 0;
+        for (const Move &move : moves)
+        {
+            Board child = board;
+            child.makeMove(move);
+            nodes += perftCopy(child, depth - 1);
+        }
+        return nodes;
+    }
+
+    int64_t elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void printRow(const std::string &name, uint64_t nodes, int64_t unmakeMs, int64_t copyMs)
+    {
+        std::cout << std::left << std::setw(12) << name << std::right
+                  << std::setw(12) << nodes
+                  << std::setw(12) << unmakeMs
+                  << std::setw(12) << copyMs
+                  << std::setw(9) << std::fixed << std::setprecision(2)
+                  << (copyMs ? (double)unmakeMs / copyMs : 0.0) << "x\n";
+    }
+
+    void printHeader(const char *title)
+    {
+        std::cout << "\n" << title << "\n"
+                  << std::left << std::setw(12) << "position" << std::right
+                  << std::setw(12) << "nodes"
+                  << std::setw(12) << "unmake ms"
+                  << std::setw(12) << "copy ms"
+                  << std::setw(10) << "speedup" << "\n";
+    }
+
+    // Nodes per second of a parallel search of every position under one NUMA policy
+    uint64_t smpNps(NumaPolicy policy, unsigned threads, size_t hashMb, int64_t timeMs, const BenchPosition &position)
+    {
+        SmpSearch search(threads, hashMb, policy);
+        Board board;
+        board.loadFEN(position.fen);
+
+        SearchLimits limits;
+        limits.timeMs = timeMs;
+        auto start = std::chrono::steady_clock::now();
+        search.run(board, limits);
+        int64_t ms = std::max<int64_t>(1, elapsedMs(start));
+        return search.getNodes() * 1000 / (uint64_t)ms;
+    }
+
+    void runSmp(unsigned threads, size_t hashMb, int64_t timeMs)
+    {
+        std::cout << "\nParallel search, " << threads << " thread(s), " << timeMs << " ms per position, "
+                  << hashMb << " MiB table\n"
+                  << Numa::nodes().size() << " NUMA node(s)"
+                  << (Numa::isMultiNode() ? "" : "; placement is a no-op on this machine") << "\n"
+                  << std::left << std::setw(12) << "position" << std::right
+                  << std::setw(12) << "off knps"
+                  << std::setw(14) << "interleave"
+                  << std::setw(12) << "replicate" << "\n";
+
+        const NumaPolicy policies[] = {NumaPolicy::OFF, NumaPolicy::INTERLEAVE, NumaPolicy::REPLICATE};
+        uint64_t totals[3] = {};
+        for (const BenchPosition &position : positions)
+        {
+            std::cout << std::left << std::setw(12) << position.name << std::right;
+            for (int p = 0; p < 3; p++)
+            {
+                uint64_t nps = smpNps(policies[p], threads, hashMb, timeMs, position);
+                totals[p] += nps;
+                std::cout << std::setw(p == 1 ? 14 : 12) << nps / 1000;
+            }
+            std::cout << "\n";
+        }
+        std::cout << std::left << std::setw(12) << "total" << std::right << std::setw(12) << totals[0] / 1000
+                  << std::setw(14) << totals[1] / 1000 << std::setw(12) << totals[2] / 1000 << "\n";
+    }
+
+    void printUsage()
+    {
+        std::cerr << "Usage: bench [--perft d] [--search d] [--threads n [--time ms] [--hash mb]]\n"
+                  << "  Times perft and fixed-depth searches with make/unmake and with copy-make.\n"
+                  << "  With --threads, also compares parallel search speed with each NUMA policy.\n"
+                  << "  Defaults: --perft 3 --search 4 --time 1000 --hash 64\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int perftDepth = 3, searchDepth = 4;
+    unsigned smpThreads = 0;
+    int64_t smpTimeMs = 1000;
+    size_t hashMb = 64;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--perft" && i + 1 < argc)
+            perftDepth = std::atoi(argv[++i]);
+        else if (arg == "--search" && i + 1 < argc)
+            searchDepth = std::atoi(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc)
+            smpThreads = (unsigned)std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--time" && i + 1 < argc)
+            smpTimeMs = std::max(1LL, std::atoll(argv[++i]));
+        else if (arg == "--hash" && i + 1 < argc)
+            hashMb = (size_t)std::max(1, std::atoi(argv[++i]));
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::cout << "sizeof(Board) = " << sizeof(Board) << " bytes\n";
+
+    int64_t totalUnmake = 0, totalCopy = 0;
+    if (perftDepth > 0)
+    {
+        printHeader(("Perft, depth " + std::to_string(perftDepth)).c_str());
+        for (const BenchPosition &position : positions)
+        {
+            Board board;
+            board.loadFEN(position.fen);
+
+            auto start = std::chrono::steady_clock::now();
+            uint64_t nodes = perftUnmake(board, perftDepth);
+            int64_t unmakeMs = elapsedMs(start);
+
+            start = std::chrono::steady_clock::now();
+            uint64_t copyNodes = perftCopy(board, perftDepth);
+            int64_t copyMs = elapsedMs(start);
+
+            if (nodes != copyNodes)
+            {
+                std::cerr << position.name << ": node counts differ (" << nodes << " vs " << copyNodes << ")\n";
+                return 1;
+            }
+            printRow(position.name, nodes, unmakeMs, copyMs);
+            totalUnmake += unmakeMs;
+            totalCopy += copyMs;
+        }
+    }
+
+    if (searchDepth > 0)
+    {
+        printHeader(("Search, depth " + std::to_string(searchDepth)).c_str());
+        SearchLimits limits;
+        limits.depth = searchDepth;
+        for (const BenchPosition &position : positions)
+        {
+            Board board;
+            board.loadFEN(position.fen);
+
+            Search search;
+            search.setCopyMake(false);
+            auto start = std::chrono::steady_clock::now();
+            SearchInfo unmakeInfo = search.run(board, limits);
+            int64_t unmakeMs = elapsedMs(start);
+
+            search.setCopyMake(true);
+            start = std::chrono::steady_clock::now();
+            SearchInfo copyInfo = search.run(board, limits);
+            int64_t copyMs = elapsedMs(start);
+
+            if (unmakeInfo.nodes != copyInfo.nodes)
+            {
+                std::cerr << position.name << ": searches differ (" << unmakeInfo.nodes << " vs " << copyInfo.nodes << " nodes)\n";
+                return 1;
+            }
+            printRow(position.name, unmakeInfo.nodes, unmakeMs, copyMs);
+            totalUnmake += unmakeMs;
+            totalCopy += copyMs;
+        }
+    }
+
+    std::cout << "\nTotal: make/unmake " << totalUnmake << " ms, copy-make " << totalCopy << " ms\n";
+
+    if (smpThreads > 0)
+        runSmp(smpThreads, hashMb, smpTimeMs);
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "Dedup.h"
+#include "Parallel.h"
+#include "Pgn.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "Usage: dedup [--position] [--keep-prefixes] [--threads n] -o <out.pgn> <in.pgn>...\n"
+                  << "Writes every game that is neither a duplicate of an earlier game nor the\n"
+                  << "opening of a longer one. --position compares final positions instead of moves.\n";
+    }
+
+    int64_t millisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string outputPath;
+    std::vector<std::string> inputs;
+    Deduplicator::Mode mode = Deduplicator::Mode::MOVES;
+    bool dropPrefixes = true;
+    unsigned threads = defaultThreadCount();
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc)
+            outputPath = argv[++i];
+        else if (arg == "--position")
+            mode = Deduplicator::Mode::POSITION;
+        else if (arg == "--keep-prefixes")
+            dropPrefixes = false;
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg[0] != '-')
+            inputs.push_back(arg);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (outputPath.empty() || inputs.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<PgnGame> games;
+    for (const std::string &path : inputs)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "Fatal error: cannot open " << path << std::endl;
+            return 1;
+        }
+        PgnReader reader(file);
+        PgnGame game;
+        while (reader.next(game))
+            games.push_back(std::move(game));
+    }
+    int64_t readMs = millisecondsSince(startTime);
+
+    Deduplicator deduplicator(mode, dropPrefixes);
+    std::vector<GameStatus> status = deduplicator.run(games, threads);
+    int64_t dedupMs = millisecondsSince(startTime) - readMs;
+
+    std::ofstream output(outputPath, std::ios::binary);
+    if (!output)
+    {
+        std::cerr << "Fatal error: cannot write " << outputPath << std::endl;
+        return 1;
+    }
+
+    size_t written = 0, duplicates = 0, prefixes = 0, invalid = 0;
+    for (size_t i = 0; i < games.size(); i++)
+    {
+        if (status[i] == GameStatus::DUPLICATE)
+        {
+            duplicates++;
+            continue;
+        }
+        if (status[i] == GameStatus::PREFIX)
+        {
+            prefixes++;
+            continue;
+        }
+        if (status[i] == GameStatus::INVALID)
+            invalid++;
+
+        std::string text = games[i].text;
+        while (!text.empty() && (text.back() == '\n' || text.back() == ' '))
+            text.pop_back();
+        output << text << "\n\n";
+        written++;
+    }
+
+    std::cout << "Read " << games.size() << " games in " << readMs << " ms\n"
+              << "Duplicates: " << duplicates << "\n"
+              << "Prefixes of longer games: " << prefixes << "\n";
+    if (invalid)
+        std::cout << "Unreadable games kept: " << invalid << "\n";
+    std::cout << "Wrote " << written << " games to " << outputPath << "\n"
+              << "Deduplication took " << dedupMs << " ms on " << threads << " thread(s)\n";
+
+    return 0;
+}
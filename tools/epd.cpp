@@ -0,0 +1,182 @@
+#include "Board.h"
+#include "Epd.h"
+#include "Notation.h"
+#include "Parallel.h"
+#include "Search.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct EpdResult
+    {
+        bool valid = false;
+        bool solved = false;
+        std::string bestSan;
+        int depth = 0;
+        uint64_t nodes = 0;
+        int64_t timeMs = 0;
+        int64_t solveMs = -1; // Time of the iteration from which the answer stayed correct
+    };
+
+    bool isSolution(const Move &move, const std::vector<Move> &best, const std::vector<Move> &avoid)
+    {
+        if (std::find(avoid.begin(), avoid.end(), move) != avoid.end())
+            return false;
+        return best.empty() || std::find(best.begin(), best.end(), move) != best.end();
+    }
+
+    EpdResult solve(const EpdEntry &entry, const SearchLimits &limits)
+    {
+        EpdResult result;
+        Board board;
+        if (!board.loadFEN(entry.fen))
+            return result;
+
+        std::vector<Move> best, avoid;
+        for (const std::string &san : entry.bestMoves)
+            best.push_back(Notation::fromSan(board, san));
+        for (const std::string &san : entry.avoidMoves)
+            avoid.push_back(Notation::fromSan(board, san));
+        bool unreadable = std::find(best.begin(), best.end(), Move()) != best.end() ||
+                          std::find(avoid.begin(), avoid.end(), Move()) != avoid.end();
+        if ((best.empty() && avoid.empty()) || unreadable)
+            return result;
+
+        // Track the iteration from which the best move stayed correct
+        auto onIteration = [&](const SearchInfo &iteration)
+        {
+            if (!isSolution(iteration.bestMove(), best, avoid))
+            {
+                result.solveMs = -1;
+            }
+            else if (result.solveMs < 0)
+            {
+                result.solveMs = iteration.timeMs;
+            }
+        };
+
+        Search search;
+        SearchInfo info = search.run(board, limits, onIteration);
+
+        result.valid = true;
+        result.solved = isSolution(info.bestMove(), best, avoid);
+        if (!result.solved)
+            result.solveMs = -1;
+        result.bestSan = info.bestMove().isNull() ? "-" : Notation::toSan(board, info.bestMove());
+        result.depth = info.depth;
+        result.nodes = info.nodes;
+        result.timeMs = info.timeMs;
+        return result;
+    }
+
+    void printUsage()
+    {
+        std::cerr << "Usage: epd <file.epd> [--time ms] [--nodes n] [--depth d] [--threads n]\n"
+                  << "Solves every position with a fixed budget per position, in parallel.\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path;
+    SearchLimits limits;
+    unsigned threadCount = defaultThreadCount();
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--time" && hasValue)
+            limits.timeMs = std::atoll(argv[++i]);
+        else if (arg == "--nodes" && hasValue)
+            limits.nodes = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--depth" && hasValue)
+            limits.depth = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue)
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (path.empty() && arg[0] != '-')
+            path = arg;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (path.empty())
+    {
+        printUsage();
+        return 1;
+    }
+    if (!limits.timeMs && !limits.nodes && limits.depth == SearchLimits().depth)
+        limits.timeMs = 1000;
+
+    std::vector<EpdEntry> entries;
+    try
+    {
+        entries = Epd::loadFile(path);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Each worker owns its board and search, and pulls the next unsolved position
+    std::vector<EpdResult> results(entries.size());
+    auto startTime = std::chrono::steady_clock::now();
+    threadCount = std::min<unsigned>(threadCount, std::max<size_t>(1, entries.size()));
+    parallelFor(entries.size(), threadCount, [&](size_t i)
+                { results[i] = solve(entries[i], limits); });
+
+    int64_t wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::steady_clock::now() - startTime)
+                         .count();
+
+    int solved = 0, valid = 0;
+    uint64_t totalNodes = 0;
+    int64_t totalSolveMs = 0;
+    std::cout << std::left << std::setw(20) << "id" << std::setw(8) << "result" << std::setw(10) << "move"
+              << std::right << std::setw(6) << "depth" << std::setw(12) << "nodes" << std::setw(10) << "time"
+              << std::setw(10) << "solve" << "\n";
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const EpdResult &result = results[i];
+        std::string id = entries[i].id.empty() ? "#" + std::to_string(i + 1) : entries[i].id;
+        std::cout << std::left << std::setw(20) << id;
+        if (!result.valid)
+        {
+            std::cout << "invalid\n";
+            continue;
+        }
+
+        valid++;
+        totalNodes += result.nodes;
+        if (result.solved)
+        {
+            solved++;
+            totalSolveMs += result.solveMs;
+        }
+        std::cout << std::setw(8) << (result.solved ? "ok" : "FAIL") << std::setw(10) << result.bestSan
+                  << std::right << std::setw(6) << result.depth << std::setw(12) << result.nodes
+                  << std::setw(8) << result.timeMs << "ms";
+        if (result.solved)
+            std::cout << std::setw(8) << result.solveMs << "ms";
+        std::cout << "\n";
+    }
+
+    std::cout << "\nSolved " << solved << " / " << valid;
+    if (valid)
+        std::cout << " (" << std::fixed << std::setprecision(1) << 100.0 * solved / valid << "%)";
+    std::cout << "\nAverage time to solution: " << (solved ? totalSolveMs / solved : 0) << " ms"
+              << "\nTotal nodes: " << totalNodes
+              << "\nWall time: " << wallMs << " ms on " << threadCount << " thread(s)\n";
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "Board.h"
+#include "Notation.h"
+#include "OpeningExplorer.h"
+#include "Pgn.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "Usage: explorer <games.pgn> [--plies n] [--cache n]\n"
+                  << "Then enter one position per line: a move list from the start (\"e4 e5 Nf3\"),\n"
+                  << "\"fen <FEN>\", or an empty line for the starting position.\n";
+    }
+
+    // Sets up the board described by one input line
+    bool setupPosition(const std::string &line, Board &board)
+    {
+        if (line.compare(0, 4, "fen ") == 0)
+            return board.loadFEN(line.substr(4));
+
+        board.initialize();
+        std::istringstream in(line);
+        std::string token;
+        while (in >> token)
+        {
+            Move move = Notation::fromSan(board, token);
+            if (move.isNull())
+                move = Notation::fromUci(board, token);
+            if (move.isNull())
+            {
+                std::cout << "Illegal move: " << token << "\n";
+                return false;
+            }
+            board.makeMove(move);
+        }
+        return true;
+    }
+
+    double percent(uint32_t part, uint32_t whole)
+    {
+        return whole ? 100.0 * part / whole : 0.0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path;
+    int plies = 16;
+    size_t cacheSize = 4096;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--plies" && i + 1 < argc)
+            plies = std::atoi(argv[++i]);
+        else if (arg == "--cache" && i + 1 < argc)
+            cacheSize = std::strtoull(argv[++i], nullptr, 10);
+        else if (path.empty() && arg[0] != '-')
+            path = arg;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (path.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Fatal error: cannot open " << path << std::endl;
+        return 1;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    OpeningExplorer explorer(plies, cacheSize);
+    PgnReader reader(file);
+    PgnGame game;
+    size_t skipped = 0;
+    while (reader.next(game))
+    {
+        if (!explorer.addGame(game))
+            skipped++;
+    }
+    explorer.finalize();
+    auto buildMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - startTime)
+                       .count();
+
+    std::cout << "Indexed " << explorer.getGameCount() << " games (" << skipped << " skipped), "
+              << explorer.getPrecomputedCount() << " precomputed positions in " << buildMs << " ms\n";
+
+    std::string line;
+    Board board;
+    while (std::getline(std::cin, line))
+    {
+        if (!setupPosition(line, board))
+            continue;
+
+        auto queryStart = std::chrono::steady_clock::now();
+        std::vector<MoveStats> stats = explorer.query(board);
+        auto queryUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - queryStart)
+                           .count();
+
+        std::cout << std::left << std::setw(10) << "move" << std::right << std::setw(10) << "games"
+                  << std::setw(9) << "white" << std::setw(9) << "draw" << std::setw(9) << "black"
+                  << std::setw(9) << "rating" << "\n";
+        std::cout << std::fixed << std::setprecision(1);
+        for (const MoveStats &entry : stats)
+        {
+            std::cout << std::left << std::setw(10) << entry.san << std::right << std::setw(10) << entry.games
+                      << std::setw(8) << percent(entry.whiteWins, entry.games) << "%"
+                      << std::setw(8) << percent(entry.draws, entry.games) << "%"
+                      << std::setw(8) << percent(entry.blackWins, entry.games) << "%"
+                      << std::setw(9) << entry.averageRating() << "\n";
+        }
+        std::cout << stats.size() << " moves in " << queryUs << " us\n\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include "Board.h"
+#include "Mcts.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include "Numa.h"
+#include "Parallel.h"
+#include "SmpSearch.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int MAX_GAME_PLIES = 200;
+
+    // Short, balanced openings; each is played once with either engine as White
+    const char *openings[] = {
+        "e2e4 e7e5 g1f3 b8c6",
+        "d2d4 d7d5 c2c4 e7e6",
+        "e2e4 c7c5 g1f3 d7d6",
+        "d2d4 g8f6 c2c4 g7g6",
+        "c2c4 e7e5 b1c3 g8f6",
+        "e2e4 e7e6 d2d4 d7d5",
+    };
+
+    enum class Outcome
+    {
+        WHITE_WINS,
+        BLACK_WINS,
+        DRAW
+    };
+
+    struct EngineStats
+    {
+        uint64_t work = 0;   // Playouts for MCTS, nodes for alpha-beta
+        int64_t timeMs = 0;
+        uint64_t reused = 0;  // Tree nodes, or table hits, carried over from the previous move
+        uint64_t total = 0;   // Tree nodes, or nodes, to compare reused with
+    };
+
+    struct MatchGame
+    {
+        bool mctsWhite;
+        Outcome outcome;
+        std::string reason;
+        int plies;
+    };
+
+    // Result of the position if the game is over, judged before the side to move plays
+    bool isOver(Board &board, const std::vector<uint64_t> &history, Outcome &outcome, std::string &reason)
+    {
+        Color us = board.getSideToMove();
+        MoveList moves;
+        MoveGen::generate(GenType::LEGAL, board, us, moves);
+        if (moves.empty())
+        {
+            bool mate = board.isInCheck(us);
+            outcome = !mate ? Outcome::DRAW : (us == Color::WHITE ? Outcome::BLACK_WINS : Outcome::WHITE_WINS);
+            reason = mate ? "checkmate" : "stalemate";
+            return true;
+        }
+
+        outcome = Outcome::DRAW;
+        if (board.getHalfmoveClock() >= 100)
+        {
+            reason = "fifty moves";
+            return true;
+        }
+        if (std::count(history.begin(), history.end(), history.back()) >= 3)
+        {
+            reason = "repetition";
+            return true;
+        }
+        if (history.size() > (size_t)MAX_GAME_PLIES)
+        {
+            reason = "adjudicated";
+            return true;
+        }
+        return false;
+    }
+
+    MatchGame play(const char *opening, bool mctsWhite, Mcts &mcts, SmpSearch &alphaBeta,
+                   const SearchLimits &limits, EngineStats &mctsStats, EngineStats &alphaBetaStats)
+    {
+        Board board;
+        board.initialize();
+        alphaBeta.clearTables();
+        mcts.clear();
+
+        std::istringstream stream(opening);
+        std::string text;
+        while (stream >> text)
+            board.makeMove(Notation::fromUci(board, text));
+
+        std::vector<uint64_t> history = {Zobrist::hash(board)};
+        MatchGame game = {mctsWhite, Outcome::DRAW, "", 0};
+        while (!isOver(board, history, game.outcome, game.reason))
+        {
+            bool mctsToMove = (board.getSideToMove() == Color::WHITE) == mctsWhite;
+            SearchInfo info;
+            if (mctsToMove)
+            {
+                info = mcts.run(board, limits);
+                mctsStats.work += info.nodes;
+                mctsStats.timeMs += info.timeMs;
+                mctsStats.reused += mcts.getReusedNodes();
+                mctsStats.total += mcts.getNodeCount();
+            }
+            else
+            {
+                info = alphaBeta.run(board, limits);
+                alphaBetaStats.work += alphaBeta.getNodes();
+                alphaBetaStats.timeMs += info.timeMs;
+                alphaBetaStats.reused += alphaBeta.getReusedNodes();
+                alphaBetaStats.total += alphaBeta.getNodes();
+            }
+
+            Move move = info.bestMove();
+            if (move.isNull())
+            {
+                MoveList moves;
+                MoveGen::generate(GenType::LEGAL, board, board.getSideToMove(), moves);
+                move = moves[0];
+            }
+            board.makeMove(move);
+            history.push_back(Zobrist::hash(board));
+            game.plies++;
+        }
+        return game;
+    }
+
+    double perSecond(const EngineStats &stats)
+    {
+        return stats.timeMs ? 1000.0 * stats.work / stats.timeMs : 0.0;
+    }
+
+    double reusedPercent(const EngineStats &stats)
+    {
+        return stats.total ? 100.0 * stats.reused / stats.total : 0.0;
+    }
+
+    void printUsage()
+    {
+        std::cerr << "Usage: match [--games n] [--time ms] [--threads n] [--hash mb]\n"
+                  << "Plays the Monte Carlo tree search against the alpha-beta search, alternating\n"
+                  << "colors over a set of openings, and compares their throughput and results.\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int gameCount = 12;
+    SearchLimits limits;
+    limits.timeMs = 100;
+    unsigned threadCount = defaultThreadCount();
+    size_t hashMb = 16;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--games" && hasValue)
+            gameCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--time" && hasValue)
+            limits.timeMs = std::max(1LL, std::atoll(argv[++i]));
+        else if (arg == "--threads" && hasValue)
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--hash" && hasValue)
+            hashMb = (size_t)std::max(1, std::atoi(argv[++i]));
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    Mcts mcts(threadCount);
+    SmpSearch alphaBeta(threadCount, hashMb, NumaPolicy::OFF);
+    EngineStats mctsStats, alphaBetaStats;
+    int wins = 0, draws = 0, losses = 0;
+    const int openingCount = (int)(sizeof(openings) / sizeof(openings[0]));
+
+    std::cout << "MCTS vs alpha-beta, " << limits.timeMs << " ms per move, "
+              << threadCount << " thread(s) each\n\n";
+    for (int i = 0; i < gameCount; i++)
+    {
+        bool mctsWhite = i % 2 == 0;
+        MatchGame game = play(openings[(i / 2) % openingCount], mctsWhite, mcts, alphaBeta,
+                              limits, mctsStats, alphaBetaStats);
+
+        // Score from the MCTS side
+        std::string result;
+        if (game.outcome == Outcome::DRAW)
+        {
+            draws++;
+            result = "1/2-1/2";
+        }
+        else
+        {
+            bool whiteWon = game.outcome == Outcome::WHITE_WINS;
+            (whiteWon == mctsWhite ? wins : losses)++;
+            result = whiteWon ? "1-0" : "0-1";
+        }
+        std::cout << "Game " << std::setw(3) << i + 1 << ": "
+                  << (mctsWhite ? "MCTS - alpha-beta" : "alpha-beta - MCTS") << "  "
+                  << std::left << std::setw(8) << result << std::right
+                  << game.reason << " after " << game.plies << " plies\n";
+    }
+
+    double score = (wins + 0.5 * draws) / gameCount;
+    std::cout << "\nMCTS: +" << wins << " =" << draws << " -" << losses
+              << " (" << std::fixed << std::setprecision(1) << 100.0 * score << "%)"
+              << "\nMCTS playouts/s:      " << std::setprecision(0) << perSecond(mctsStats)
+              << "\nAlpha-beta nodes/s:   " << perSecond(alphaBetaStats)
+              << std::setprecision(1)
+              << "\nMCTS tree reused:     " << reusedPercent(mctsStats) << "%"
+              << "\nAlpha-beta reused:    " << reusedPercent(alphaBetaStats) << "% of nodes hit an earlier move's entry\n";
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "Board.h"
+#include "InputReader.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include "SessionManager.h"
+#include "SessionSlab.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "Usage: server [--idle seconds] [--slab file] [--memory-games n] [--slab-capacity n]\n"
+                  << "Reads one command per line and answers each with one line starting \"ok\" or \"error\":\n"
+                  << "  new [FEN]            open a game, answers its id\n"
+                  << "  move <id> <move>     play a move in SAN or UCI notation\n"
+                  << "  fen <id>             current position\n"
+                  << "  history <id>         moves played, in SAN\n"
+                  << "  status <id>          ongoing, check, checkmate, stalemate or draw\n"
+                  << "  close <id>           close a game\n"
+                  << "  stats                active, hibernated and spilled game counts\n"
+                  << "Games unused for --idle seconds (default 60) are hibernated until their next command.\n"
+                  << "With --slab, hibernated games beyond --memory-games (default 100000) are spilled to\n"
+                  << "the file, least recently used first, and every game is spilled on quit, so a restarted\n"
+                  << "server reopening the file can continue them. A new slab file is sized for\n"
+                  << "--slab-capacity games (default 1048576) and grows as needed.\n";
+    }
+
+    std::string status(Session &session)
+    {
+        Board &board = session.getBoard();
+        Color us = board.getSideToMove();
+        MoveList legal;
+        MoveGen::generate(GenType::LEGAL, board, us, legal);
+        bool inCheck = board.isInCheck(us);
+        if (legal.empty())
+            return inCheck ? "checkmate" : "stalemate";
+        if (board.getHalfmoveClock() >= 100)
+            return "draw";
+        return inCheck ? "check" : "ongoing";
+    }
+
+    // Runs one command against the sessions and returns the reply line
+    std::string execute(const std::string &line, SessionManager &sessions)
+    {
+        std::istringstream in(line);
+        std::string command;
+        in >> command;
+
+        if (command == "new")
+        {
+            std::string fen;
+            std::getline(in >> std::ws, fen);
+            Board board;
+            if (fen.empty())
+                board.initialize();
+            else if (!board.loadFEN(fen))
+                return "error bad FEN";
+            return "ok " + std::to_string(sessions.create(board));
+        }
+        if (command == "stats")
+        {
+            return "ok active " + std::to_string(sessions.getActiveCount()) +
+                   " hibernated " + std::to_string(sessions.getHibernatedCount()) +
+                   " spilled " + std::to_string(sessions.getSpilledCount());
+        }
+
+        uint32_t id = 0;
+        if (!(in >> id))
+            return command.empty() ? "error empty command" : "error missing game id";
+        if (command == "close")
+            return sessions.close(id) ? "ok" : "error no such game";
+
+        Session *session = sessions.find(id);
+        if (!session)
+            return "error no such game";
+        Board &board = session->getBoard();
+
+        if (command == "move")
+        {
+            std::string token;
+            in >> token;
+            Move move = Notation::fromSan(board, token);
+            if (move.isNull())
+                move = Notation::fromUci(board, token);
+            if (move.isNull())
+                return "error illegal move";
+            session->play(move);
+            return std::string("ok ") + session->getHistory().back().san;
+        }
+        if (command == "fen")
+            return "ok " + board.toFEN();
+        if (command == "history")
+        {
+            std::string reply = "ok";
+            for (const MoveRecord &record : session->getHistory())
+                reply += std::string(" ") + record.san;
+            return reply;
+        }
+        if (command == "status")
+            return "ok " + status(*session);
+
+        return "error unknown command";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int idleSeconds = 60;
+    std::string slabPath;
+    long memoryGames = 100000;
+    long slabCapacity = 1 << 20;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--idle" && i + 1 < argc)
+            idleSeconds = std::atoi(argv[++i]);
+        else if (arg == "--slab" && i + 1 < argc)
+            slabPath = argv[++i];
+        else if (arg == "--memory-games" && i + 1 < argc)
+            memoryGames = std::atol(argv[++i]);
+        else if (arg == "--slab-capacity" && i + 1 < argc)
+            slabCapacity = std::atol(argv[++i]);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    SessionManager sessions(idleSeconds);
+    std::unique_ptr<SessionSlab> slab;
+    if (!slabPath.empty())
+    {
+        try
+        {
+            slab.reset(new SessionSlab(slabPath, (uint32_t)std::min(std::max(1L, slabCapacity), 1L << 30)));
+        }
+        catch (const std::runtime_error &e)
+        {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        sessions.attachSlab(slab.get(), (size_t)std::max(0L, memoryGames));
+    }
+    auto lastSweep = std::chrono::steady_clock::now();
+
+    InputReader input;
+    std::string line;
+    while (true)
+    {
+        // Wake at least once a second, so idle sessions are hibernated even when no commands come
+        bool ready = input.waitForInput(1000);
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastSweep >= std::chrono::seconds(1))
+        {
+            sessions.hibernateIdle();
+            lastSweep = now;
+        }
+        if (!ready)
+            continue;
+
+        if (!input.readLine(line) || line == "quit")
+            break;
+        std::cout << execute(line, sessions) << "\n";
+
+        // Reply at once to an interactive client, but batch replies to piped-in commands
+        if (!input.waitForInput(0))
+            std::cout.flush();
+    }
+
+    if (slab && sessions.spillAll() > 0)
+        std::cerr << "Warning: the slab file could not grow, some games were not saved\n";
+    return 0;
+}